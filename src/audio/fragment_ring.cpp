@@ -0,0 +1,75 @@
+//  SuperTux
+//  Copyright (C) 2018 SuperTux Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "audio/fragment_ring.hpp"
+
+#include <assert.h>
+
+FragmentRing::FragmentRing(size_t capacity_) :
+  m_slots(capacity_),
+  m_read(0),
+  m_write(0)
+{
+  assert(capacity_ > 0);
+}
+
+FragmentRing::Fragment*
+FragmentRing::begin_write()
+{
+  size_t write = m_write.load(std::memory_order_relaxed);
+  if(write - m_read.load(std::memory_order_acquire) >= m_slots.size())
+    return nullptr;
+
+  return &m_slots[write % m_slots.size()];
+}
+
+void
+FragmentRing::end_write()
+{
+  m_write.store(m_write.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+const FragmentRing::Fragment*
+FragmentRing::begin_read() const
+{
+  size_t read = m_read.load(std::memory_order_relaxed);
+  if(read == m_write.load(std::memory_order_acquire))
+    return nullptr;
+
+  return &m_slots[read % m_slots.size()];
+}
+
+void
+FragmentRing::end_read()
+{
+  m_read.store(m_read.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+size_t
+FragmentRing::size() const
+{
+  size_t read = m_read.load(std::memory_order_acquire);
+  return m_write.load(std::memory_order_acquire) - read;
+}
+
+void
+FragmentRing::clear()
+{
+  m_read.store(0);
+  m_write.store(0);
+}
+
+/* EOF */
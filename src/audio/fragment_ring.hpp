@@ -0,0 +1,76 @@
+//  SuperTux
+//  Copyright (C) 2018 SuperTux Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_AUDIO_FRAGMENT_RING_HPP
+#define HEADER_SUPERTUX_AUDIO_FRAGMENT_RING_HPP
+
+#include <atomic>
+#include <stddef.h>
+#include <vector>
+
+/**
+ * Fixed size ring of decoded audio fragments, passed from the stream
+ * thread to the main thread without locking. Only one thread may
+ * write and only one thread may read. The slots keep their memory, so
+ * after the first round no fragment allocates anymore.
+ */
+class FragmentRing final
+{
+public:
+  struct Fragment
+  {
+    Fragment() : data(), size(0) {}
+
+    std::vector<char> data;
+    size_t size;
+  };
+
+public:
+  FragmentRing(size_t capacity);
+
+  /** Writer side: returns the slot to fill, nullptr if the ring is full */
+  Fragment* begin_write();
+  /** Writer side: makes the slot returned by begin_write() readable */
+  void end_write();
+
+  /** Reader side: returns the oldest fragment, nullptr if the ring is empty */
+  const Fragment* begin_read() const;
+  /** Reader side: releases the fragment returned by begin_read() */
+  void end_read();
+
+  /** number of readable fragments, only a snapshot when the other side is active */
+  size_t size() const;
+  size_t capacity() const { return m_slots.size(); }
+
+  /** Drops all fragments, neither side may be active */
+  void clear();
+
+private:
+  std::vector<Fragment> m_slots;
+
+  /** total number of fragments read and written, the slot is the
+      counter modulo the capacity */
+  std::atomic<size_t> m_read;
+  std::atomic<size_t> m_write;
+
+private:
+  FragmentRing(const FragmentRing&) = delete;
+  FragmentRing& operator=(const FragmentRing&) = delete;
+};
+
+#endif
+
+/* EOF */
@@ -20,12 +20,12 @@
 #include "util/log.hpp"
 
 OpenALSoundSource::OpenALSoundSource() :
-  source()
+  source(),
+  name()
 {
-  alGenSources(1, &source);
   try
   {
-    SoundManager::check_al_error("Couldn't create audio source: ");
+    source = SoundManager::current()->acquire_source();
   }
   catch(std::exception& e)
   {
@@ -37,7 +37,7 @@ OpenALSoundSource::OpenALSoundSource() :
 OpenALSoundSource::~OpenALSoundSource()
 {
   stop();
-  alDeleteSources(1, &source);
+  SoundManager::current()->release_source(source);
 }
 
 void
@@ -18,6 +18,7 @@
 #define HEADER_SUPERTUX_AUDIO_OPENAL_SOUND_SOURCE_HPP
 
 #include <al.h>
+#include <string>
 
 #include "audio/sound_source.hpp"
 
@@ -48,6 +49,8 @@ protected:
   friend class SoundManager;
 
   ALuint source;
+  /// name of the sound file, used for the voice limits
+  std::string name;
 
 private:
   OpenALSoundSource(const OpenALSoundSource&) = delete;
@@ -0,0 +1,120 @@
+//  SuperTux
+//  Copyright (C) 2018 SuperTux Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "audio/sound_buffer_cache.hpp"
+
+#include <algorithm>
+
+SoundBufferCache::SoundBufferCache(size_t budget) :
+  m_budget(budget),
+  m_entries(),
+  m_pinned(),
+  m_use_counter(0),
+  m_stats()
+{
+}
+
+unsigned int
+SoundBufferCache::get(const std::string& name)
+{
+  auto it = m_entries.find(name);
+  if(it == m_entries.end()) {
+    m_stats.misses += 1;
+    return 0;
+  }
+
+  m_stats.hits += 1;
+  it->second.last_use = ++m_use_counter;
+  return it->second.buffer;
+}
+
+bool
+SoundBufferCache::contains(const std::string& name) const
+{
+  return m_entries.find(name) != m_entries.end();
+}
+
+void
+SoundBufferCache::insert(const std::string& name, unsigned int buffer, size_t bytes)
+{
+  erase(name);
+
+  m_entries[name] = { buffer, bytes, ++m_use_counter };
+  m_stats.bytes += bytes;
+  m_stats.buffers += 1;
+}
+
+void
+SoundBufferCache::erase(const std::string& name)
+{
+  auto it = m_entries.find(name);
+  if(it == m_entries.end())
+    return;
+
+  m_stats.bytes -= it->second.bytes;
+  m_stats.buffers -= 1;
+  m_entries.erase(it);
+}
+
+void
+SoundBufferCache::evict(const std::string& name)
+{
+  if(!contains(name))
+    return;
+
+  erase(name);
+  m_stats.evictions += 1;
+}
+
+std::vector<std::pair<std::string, unsigned int> >
+SoundBufferCache::get_eviction_candidates() const
+{
+  std::vector<std::pair<unsigned int, const std::string*> > order;
+  for(const auto& it : m_entries) {
+    if(m_pinned.find(it.first) == m_pinned.end())
+      order.push_back(std::make_pair(it.second.last_use, &it.first));
+  }
+  std::sort(order.begin(), order.end());
+
+  std::vector<std::pair<std::string, unsigned int> > result;
+  result.reserve(order.size());
+  for(const auto& it : order) {
+    result.push_back(std::make_pair(*it.second, m_entries.find(*it.second)->second.buffer));
+  }
+  return result;
+}
+
+void
+SoundBufferCache::set_pinned(const std::vector<std::string>& names)
+{
+  m_pinned = std::set<std::string>(names.begin(), names.end());
+}
+
+std::vector<unsigned int>
+SoundBufferCache::clear()
+{
+  std::vector<unsigned int> result;
+  result.reserve(m_entries.size());
+  for(const auto& it : m_entries) {
+    result.push_back(it.second.buffer);
+  }
+  m_entries.clear();
+  m_stats.bytes = 0;
+  m_stats.buffers = 0;
+  return result;
+}
+
+/* EOF */
@@ -0,0 +1,99 @@
+//  SuperTux
+//  Copyright (C) 2018 SuperTux Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_AUDIO_SOUND_BUFFER_CACHE_HPP
+#define HEADER_SUPERTUX_AUDIO_SOUND_BUFFER_CACHE_HPP
+
+#include <set>
+#include <stddef.h>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * Bookkeeping for the OpenAL buffers of the SoundManager. Maps sound
+ * names to buffers and remembers their size and last use, so that the
+ * least recently used buffers can be freed once the cached sounds
+ * exceed the byte budget. It doesn't call OpenAL itself, deleting the
+ * buffers is left to the SoundManager.
+ */
+class SoundBufferCache final
+{
+public:
+  struct Stats
+  {
+    Stats() : bytes(0), buffers(0), hits(0), misses(0), evictions(0) {}
+
+    size_t bytes;
+    size_t buffers;
+    int hits;
+    int misses;
+    int evictions;
+  };
+
+public:
+  SoundBufferCache(size_t budget);
+
+  /** Returns the buffer of the sound and marks it as recently used,
+      0 if it isn't cached. Counts as a cache hit or miss. */
+  unsigned int get(const std::string& name);
+
+  bool contains(const std::string& name) const;
+
+  void insert(const std::string& name, unsigned int buffer, size_t bytes);
+  void erase(const std::string& name);
+
+  /** Removes an entry to free memory, counted in the statistics */
+  void evict(const std::string& name);
+
+  bool over_budget() const { return m_stats.bytes > m_budget; }
+
+  /** Returns the unpinned entries, least recently used first */
+  std::vector<std::pair<std::string, unsigned int> > get_eviction_candidates() const;
+
+  /** Sounds that are never evicted, usually the sounds of the current level */
+  void set_pinned(const std::vector<std::string>& names);
+
+  /** Removes all entries and returns their buffers */
+  std::vector<unsigned int> clear();
+
+  size_t get_budget() const { return m_budget; }
+  const Stats& get_stats() const { return m_stats; }
+
+private:
+  struct Entry
+  {
+    unsigned int buffer;
+    size_t bytes;
+    unsigned int last_use;
+  };
+
+private:
+  size_t m_budget;
+  std::unordered_map<std::string, Entry> m_entries;
+  std::set<std::string> m_pinned;
+  unsigned int m_use_counter;
+  Stats m_stats;
+
+private:
+  SoundBufferCache(const SoundBufferCache&) = delete;
+  SoundBufferCache& operator=(const SoundBufferCache&) = delete;
+};
+
+#endif
+
+/* EOF */
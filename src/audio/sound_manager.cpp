@@ -17,23 +17,72 @@
 #include "audio/sound_manager.hpp"
 
 #include <SDL.h>
+#include <algorithm>
 #include <assert.h>
+#include <chrono>
 #include <stdexcept>
 #include <sstream>
 #include <memory>
 
 #include "audio/dummy_sound_source.hpp"
 #include "audio/sound_file.hpp"
+#include "audio/stream_decoder.hpp"
 #include "audio/stream_sound_source.hpp"
 #include "util/log.hpp"
+#include "util/reader_document.hpp"
+#include "util/reader_mapping.hpp"
+
+namespace {
+
+// sounds above this size are streamed instead of being kept in a buffer
+const size_t MAX_BUFFER_FILE_SIZE = 100000;
+
+// total size of the sound buffers before the least recently used are freed
+const size_t BUFFER_BUDGET = 16 * 1024 * 1024;
+
+// how often the stream thread checks whether the streams need more data
+const int STREAM_DECODE_INTERVAL = 20;
+
+// sources allocated at startup, more are generated when they run out
+const size_t SOURCE_POOL_SIZE = 64;
+
+} // namespace
+
+SoundManager::Voice::Voice(std::unique_ptr<OpenALSoundSource> source_, const std::string& name_,
+                           int priority_, unsigned int frame_) :
+  source(std::move(source_)),
+  name(name_),
+  priority(priority_),
+  frame(frame_)
+{
+}
 
 SoundManager::SoundManager() :
   device(alcOpenDevice(0)),
   context(alcCreateContext(device, /* attributes = */ 0)),
   sound_enabled(false),
-  buffers(),
-  sources(),
+  buffers(BUFFER_BUDGET),
+  decoded_sounds(),
+  decoded_mutex(),
+  decode_thread(),
+  decode_cond(),
+  decode_queue(),
+  decode_current(),
+  decode_quit(false),
+  recording_manifest(false),
+  manifest(),
+  free_sources(),
+  voices(),
+  max_voices(32),
+  voice_limits(),
+  default_voice_limit(),
+  frame(0),
   update_list(),
+  stream_decoders(),
+  stream_thread(),
+  stream_mutex(),
+  stream_cond(),
+  stream_quit(false),
   music_source(),
   music_enabled(false),
   current_music()
@@ -51,6 +100,17 @@ SoundManager::SoundManager() :
     music_enabled = true;
 
     set_listener_orientation(Vector(0.0f, 0.0f), Vector(0.0f, -1.0f));
+
+    // generating sources is slow on some drivers, reuse a fixed set instead
+    for(size_t i = 0; i < SOURCE_POOL_SIZE; ++i) {
+      ALuint source;
+      alGenSources(1, &source);
+      if(alGetError() != AL_NO_ERROR)
+        break;
+      free_sources.push_back(source);
+    }
+
+    load_voice_limits("sounds/voices.stsi");
   } catch(std::exception& e) {
     if(context != NULL) {
       alcDestroyContext(context);
@@ -67,12 +127,33 @@ SoundManager::SoundManager() :
 
 SoundManager::~SoundManager()
 {
+  {
+    std::lock_guard<std::mutex> lock(decoded_mutex);
+    decode_quit = true;
+  }
+  decode_cond.notify_all();
+  if(decode_thread.joinable())
+    decode_thread.join();
+
+  {
+    std::lock_guard<std::mutex> lock(stream_mutex);
+    stream_quit = true;
+  }
+  stream_cond.notify_all();
+  if(stream_thread.joinable())
+    stream_thread.join();
+
   music_source.reset();
-  sources.clear();
+  voices.clear();
 
-  for(const auto& buffer : buffers) {
-    alDeleteBuffers(1, &buffer.second);
+  const auto& stats = buffers.get_stats();
+  log_debug << "Sound buffer cache: " << stats.hits << " hits, " << stats.misses << " misses, "
+            << stats.evictions << " evictions" << std::endl;
+  for(auto buffer : buffers.clear()) {
+    alDeleteBuffers(1, &buffer);
   }
+  if(!free_sources.empty())
+    alDeleteSources(static_cast<ALsizei>(free_sources.size()), free_sources.data());
 
   if(context != NULL) {
     alcDestroyContext(context);
@@ -87,26 +168,305 @@ SoundManager::~SoundManager()
 ALuint
 SoundManager::load_file_into_buffer(SoundFile& file)
 {
-  ALenum format = get_sample_format(file);
+  return create_buffer(*decode_file(file));
+}
+
+std::unique_ptr<SoundManager::DecodedSound>
+SoundManager::decode_file(SoundFile& file)
+{
+  std::unique_ptr<DecodedSound> sound(new DecodedSound);
+  sound->format = get_sample_format(file);
+  sound->rate = static_cast<ALsizei>(file.rate);
+  sound->samples.resize(file.size);
+  file.read(sound->samples.data(), file.size);
+  return sound;
+}
+
+ALuint
+SoundManager::create_buffer(const DecodedSound& sound)
+{
   ALuint buffer;
   alGenBuffers(1, &buffer);
   check_al_error("Couldn't create audio buffer: ");
-  std::unique_ptr<char[]> samples(new char[file.size]);
-  file.read(samples.get(), file.size);
   log_debug << "buffer: " << buffer << "\n"
-            << "format: " << format << "\n"
-            << "samples: " << samples.get() << "\n"
-            << "file size: " << static_cast<ALsizei>(file.size) << "\n"
-            << "file rate: " << static_cast<ALsizei>(file.rate) << "\n";
-
-  alBufferData(buffer, format, samples.get(),
-               static_cast<ALsizei>(file.size),
-               static_cast<ALsizei>(file.rate));
+            << "format: " << sound.format << "\n"
+            << "file size: " << static_cast<ALsizei>(sound.samples.size()) << "\n"
+            << "file rate: " << sound.rate << "\n";
+
+  alBufferData(buffer, sound.format, sound.samples.data(),
+               static_cast<ALsizei>(sound.samples.size()),
+               sound.rate);
   check_al_error("Couldn't fill audio buffer: ");
 
   return buffer;
 }
 
+ALuint
+SoundManager::take_decoded(const std::string& filename)
+{
+  std::unique_ptr<DecodedSound> sound;
+  {
+    std::lock_guard<std::mutex> lock(decoded_mutex);
+    auto i = decoded_sounds.find(filename);
+    if(i == decoded_sounds.end())
+      return 0;
+    sound = std::move(i->second);
+    decoded_sounds.erase(i);
+  }
+
+  // decoded again while the buffer was still cached
+  if(buffers.contains(filename))
+    return buffers.get(filename);
+
+  ALuint buffer = create_buffer(*sound);
+  buffers.insert(filename, buffer, sound->samples.size());
+  return buffer;
+}
+
+void
+SoundManager::queue_decode(const std::string& filename)
+{
+  std::lock_guard<std::mutex> lock(decoded_mutex);
+  if(decoded_sounds.find(filename) != decoded_sounds.end() ||
+     decode_current == filename ||
+     std::find(decode_queue.begin(), decode_queue.end(), filename) != decode_queue.end())
+    return;
+
+  decode_queue.push_back(filename);
+  if(!decode_thread.joinable())
+    decode_thread = std::thread(&SoundManager::decode_thread_main, this);
+  decode_cond.notify_one();
+}
+
+void
+SoundManager::wait_for_decode(const std::string& filename)
+{
+  std::unique_lock<std::mutex> lock(decoded_mutex);
+  auto i = std::find(decode_queue.begin(), decode_queue.end(), filename);
+  if(i != decode_queue.end()) {
+    // not started yet, decoding it here beats waiting for the rest of the queue
+    decode_queue.erase(i);
+    lock.unlock();
+    decode(filename);
+    return;
+  }
+
+  decode_cond.wait(lock, [this, &filename] { return decode_current != filename; });
+}
+
+void
+SoundManager::decode_thread_main()
+{
+  std::unique_lock<std::mutex> lock(decoded_mutex);
+  while(true) {
+    decode_cond.wait(lock, [this] { return decode_quit || !decode_queue.empty(); });
+    if(decode_quit)
+      return;
+
+    decode_current = decode_queue.front();
+    decode_queue.pop_front();
+
+    lock.unlock();
+    decode(decode_current);
+    lock.lock();
+
+    decode_current.clear();
+    decode_cond.notify_all();
+  }
+}
+
+void
+SoundManager::evict_buffers()
+{
+  if(!buffers.over_budget())
+    return;
+
+  for(const auto& candidate : buffers.get_eviction_candidates()) {
+    // buffers still attached to a source can't be deleted, OpenAL reports
+    // AL_INVALID_OPERATION and keeps them
+    alGetError();
+    alDeleteBuffers(1, &candidate.second);
+    if(alGetError() == AL_NO_ERROR)
+      buffers.evict(candidate.first);
+
+    if(!buffers.over_budget())
+      break;
+  }
+}
+
+void
+SoundManager::stream_thread_main()
+{
+  std::vector<std::shared_ptr<StreamDecoder> > decoders;
+  std::unique_lock<std::mutex> lock(stream_mutex);
+  while(!stream_quit) {
+    stream_decoders.erase(std::remove_if(stream_decoders.begin(), stream_decoders.end(),
+                                         [](const std::shared_ptr<StreamDecoder>& decoder) {
+                                           return decoder->is_detached();
+                                         }),
+                          stream_decoders.end());
+    decoders = stream_decoders;
+
+    // the main thread only ever waits for the list copy, not for decoding
+    lock.unlock();
+    for(const auto& decoder : decoders) {
+      decoder->decode_fragments();
+    }
+    // detached decoders may be freed here, outside of the lock
+    decoders.clear();
+    lock.lock();
+
+    if(stream_quit)
+      break;
+
+    if(stream_decoders.empty()) {
+      stream_cond.wait(lock);
+    } else {
+      stream_cond.wait_for(lock, std::chrono::milliseconds(STREAM_DECODE_INTERVAL));
+    }
+  }
+}
+
+ALuint
+SoundManager::acquire_source()
+{
+  if(!free_sources.empty()) {
+    ALuint source = free_sources.back();
+    free_sources.pop_back();
+    return source;
+  }
+
+  ALuint source = 0;
+  alGenSources(1, &source);
+  check_al_error("Couldn't create audio source: ");
+  return source;
+}
+
+void
+SoundManager::release_source(ALuint source)
+{
+  // undo everything an OpenALSoundSource may have changed
+  alGetError();
+  alSourceRewind(source);
+  alSourcei(source, AL_BUFFER, AL_NONE);
+  alSourcei(source, AL_LOOPING, AL_FALSE);
+  alSourcei(source, AL_SOURCE_RELATIVE, AL_FALSE);
+  alSourcef(source, AL_GAIN, 1.0f);
+  alSourcef(source, AL_PITCH, 1.0f);
+  alSource3f(source, AL_POSITION, 0, 0, 0);
+  alSource3f(source, AL_VELOCITY, 0, 0, 0);
+  if(alGetError() != AL_NO_ERROR) {
+    // probably not a valid source in the first place
+    alDeleteSources(1, &source);
+    alGetError();
+    return;
+  }
+
+  free_sources.push_back(source);
+}
+
+void
+SoundManager::load_voice_limits(const std::string& filename)
+{
+  try {
+    auto doc = ReaderDocument::parse(filename);
+    auto root = doc.get_root();
+    if(root.get_name() != "supertux-soundinfo")
+      throw std::runtime_error("file is not a supertux-soundinfo file.");
+
+    auto info = root.get_mapping();
+    info.get("voices", max_voices);
+
+    auto iter = info.get_iter();
+    while(iter.next()) {
+      if(iter.get_key() == "default") {
+        auto mapping = iter.as_mapping();
+        mapping.get("max-voices", default_voice_limit.max_voices);
+        mapping.get("priority", default_voice_limit.priority);
+      } else if(iter.get_key() == "sound") {
+        auto mapping = iter.as_mapping();
+        std::string name;
+        if(!mapping.get("name", name))
+          throw std::runtime_error("sound without name");
+
+        VoiceLimit limit = default_voice_limit;
+        mapping.get("max-voices", limit.max_voices);
+        mapping.get("priority", limit.priority);
+        voice_limits[name] = limit;
+      }
+    }
+  } catch(std::exception& e) {
+    log_warning << "Couldn't load voice limits from '" << filename << "': " << e.what() << std::endl;
+  }
+}
+
+const SoundManager::VoiceLimit&
+SoundManager::get_voice_limit(const std::string& name) const
+{
+  auto i = voice_limits.find(name);
+  if(i == voice_limits.end())
+    return default_voice_limit;
+  return i->second;
+}
+
+bool
+SoundManager::allocate_voice(const std::string& name)
+{
+  // finished voices free their source right away instead of on the next update
+  voices.erase(std::remove_if(voices.begin(), voices.end(),
+                              [](const Voice& voice) {
+                                return !voice.source->playing();
+                              }),
+               voices.end());
+
+  const VoiceLimit& limit = get_voice_limit(name);
+  if(limit.max_voices <= 0)
+    return false;
+
+  int count = 0;
+  Voices::iterator oldest = voices.end();
+  for(auto i = voices.begin(); i != voices.end(); ++i) {
+    if(i->name != name)
+      continue;
+
+    // playing the same sound twice in one frame only makes it louder
+    if(i->frame == frame)
+      return false;
+
+    if(count == 0)
+      oldest = i;
+    count += 1;
+  }
+
+  if(count >= limit.max_voices) {
+    // the newest instance of a sound is the more relevant one
+    voices.erase(oldest);
+    return true;
+  }
+
+  if(voices.size() < static_cast<size_t>(max_voices))
+    return true;
+
+  // steal the voice of lowest priority, the oldest one if several have it
+  Voices::iterator victim = voices.end();
+  for(auto i = voices.begin(); i != voices.end(); ++i) {
+    if(victim == voices.end() || i->priority < victim->priority)
+      victim = i;
+  }
+  if(victim == voices.end() || victim->priority > limit.priority)
+    return false;
+
+  voices.erase(victim);
+  return true;
+}
+
+void
+SoundManager::record(const std::string& filename)
+{
+  if(recording_manifest)
+    manifest.push_back(filename);
+}
+
 std::unique_ptr<OpenALSoundSource>
 SoundManager::intern_create_sound_source(const std::string& filename)
 {
@@ -114,22 +474,24 @@ SoundManager::intern_create_sound_source(const std::string& filename)
 
   std::unique_ptr<OpenALSoundSource> source(new OpenALSoundSource);
 
-  ALuint buffer;
-
   // reuse an existing static sound buffer
-  SoundBuffers::iterator i = buffers.find(filename);
-  if(i != buffers.end()) {
-    buffer = i->second;
-  } else {
+  ALuint buffer = buffers.get(filename);
+  if(buffer == 0) {
+    // preloaded sounds might still be decoded in the background
+    wait_for_decode(filename);
+    buffer = take_decoded(filename);
+  }
+  if(buffer == 0) {
     // Load sound file
     std::unique_ptr<SoundFile> file(load_sound_file(filename));
 
-    if(file->size < 100000) {
+    if(file->size < MAX_BUFFER_FILE_SIZE) {
       buffer = load_file_into_buffer(*file);
-      buffers.insert(std::make_pair(filename, buffer));
+      buffers.insert(filename, buffer, file->size);
     } else {
       std::unique_ptr<StreamSoundSource> source_(new StreamSoundSource);
       source_->set_sound_file(std::move(file));
+      source_->name = filename;
       return std::move(source_);
     }
 
@@ -137,6 +499,7 @@ SoundManager::intern_create_sound_source(const std::string& filename)
   }
 
   alSourcei(source->source, AL_BUFFER, buffer);
+  source->name = filename;
   return source;
 }
 
@@ -146,6 +509,7 @@ SoundManager::create_sound_source(const std::string& filename)
   if(!sound_enabled)
     return create_dummy_sound_source();
 
+  record(filename);
   try {
     return intern_create_sound_source(filename);
   } catch(std::exception &e) {
@@ -160,20 +524,85 @@ SoundManager::preload(const std::string& filename)
   if(!sound_enabled)
     return;
 
-  SoundBuffers::iterator i = buffers.find(filename);
+  record(filename);
+
   // already loaded?
-  if(i != buffers.end())
+  if(buffers.contains(filename))
     return;
   try {
-    std::unique_ptr<SoundFile> file (load_sound_file(filename));
-    // only keep small files
-    if(file->size >= 100000)
+    if(take_decoded(filename) != 0)
       return;
-
-    ALuint buffer = load_file_into_buffer(*file);
-    buffers.insert(std::make_pair(filename, buffer));
   } catch(std::exception& e) {
     log_warning << "Error while preloading sound file: " << e.what() << std::endl;
+    return;
+  }
+
+  queue_decode(filename);
+}
+
+void
+SoundManager::decode(const std::string& filename)
+{
+  if(!sound_enabled)
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(decoded_mutex);
+    if(decoded_sounds.find(filename) != decoded_sounds.end())
+      return;
+  }
+
+  try {
+    std::unique_ptr<SoundFile> file (load_sound_file(filename));
+    // only small files are kept in buffers, the rest is streamed
+    if(file->size >= MAX_BUFFER_FILE_SIZE)
+      return;
+
+    std::unique_ptr<DecodedSound> sound = decode_file(*file);
+    std::lock_guard<std::mutex> lock(decoded_mutex);
+    decoded_sounds[filename] = std::move(sound);
+  } catch(std::exception&) {
+    // not logged as this may run on another thread, loading the sound
+    // the normal way later reports the error
+  }
+}
+
+bool
+SoundManager::is_loaded(const std::string& filename) const
+{
+  return buffers.contains(filename);
+}
+
+void
+SoundManager::begin_manifest()
+{
+  recording_manifest = true;
+  manifest.clear();
+}
+
+std::vector<std::string>
+SoundManager::end_manifest()
+{
+  recording_manifest = false;
+
+  std::vector<std::string> result;
+  std::swap(result, manifest);
+  std::sort(result.begin(), result.end());
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+  return result;
+}
+
+void
+SoundManager::set_manifest(const std::vector<std::string>& names)
+{
+  buffers.set_pinned(names);
+
+  if(!sound_enabled)
+    return;
+
+  for(const auto& name : names) {
+    if(!buffers.contains(name))
+      queue_decode(name);
   }
 }
 
@@ -183,6 +612,9 @@ SoundManager::play(const std::string& filename, const Vector& pos)
   if(!sound_enabled)
     return;
 
+  if(!allocate_voice(filename))
+    return;
+
   try {
     std::unique_ptr<OpenALSoundSource> source(intern_create_sound_source(filename));
 
@@ -192,7 +624,7 @@ SoundManager::play(const std::string& filename, const Vector& pos)
       source->set_position(pos);
     }
     source->play();
-    sources.push_back(std::move(source));
+    voices.push_back(Voice(std::move(source), filename, get_voice_limit(filename).priority, frame));
   } catch(std::exception& e) {
     log_warning << "Couldn't play sound " << filename << ": " << e.what() << std::endl;
   }
@@ -205,7 +637,11 @@ SoundManager::manage_source(std::unique_ptr<SoundSource> source)
   if (dynamic_cast<OpenALSoundSource*>(source.get()))
   {
     std::unique_ptr<OpenALSoundSource> openal_source(dynamic_cast<OpenALSoundSource*>(source.release()));
-    sources.push_back(std::move(openal_source));
+    std::string name = openal_source->name;
+    // a source that doesn't get a voice is stopped by deleting it
+    if(!allocate_voice(name))
+      return;
+    voices.push_back(Voice(std::move(openal_source), name, get_voice_limit(name).priority, frame));
   }
 }
 
@@ -234,6 +670,16 @@ SoundManager::remove_from_update(StreamSoundSource* sss)
   }
 }
 
+void
+SoundManager::start_decode(const std::shared_ptr<StreamDecoder>& decoder)
+{
+  std::lock_guard<std::mutex> lock(stream_mutex);
+  stream_decoders.push_back(decoder);
+  if (!stream_thread.joinable())
+    stream_thread = std::thread(&SoundManager::stream_thread_main, this);
+  stream_cond.notify_one();
+}
+
 void
 SoundManager::enable_sound(bool enable)
 {
@@ -331,9 +777,9 @@ SoundManager::pause_music(float fadetime)
 void
 SoundManager::pause_sounds()
 {
-  for(auto& source : sources) {
-    if(source->playing()) {
-      source->pause();
+  for(auto& voice : voices) {
+    if(voice.source->playing()) {
+      voice.source->pause();
     }
   }
 }
@@ -341,9 +787,9 @@ SoundManager::pause_sounds()
 void
 SoundManager::resume_sounds()
 {
-  for(auto& source : sources) {
-    if(source->paused()) {
-      source->resume();
+  for(auto& voice : voices) {
+    if(voice.source->paused()) {
+      voice.source->resume();
     }
   }
 }
@@ -351,8 +797,8 @@ SoundManager::resume_sounds()
 void
 SoundManager::stop_sounds()
 {
-  for(auto& source : sources) {
-    source->stop();
+  for(auto& voice : voices) {
+    voice.source->stop();
   }
 }
 
@@ -400,6 +846,14 @@ SoundManager::set_listener_orientation(const Vector& at, const Vector& up)
 void
 SoundManager::update()
 {
+  frame += 1;
+
+  // hand the fragments decoded on the stream thread to OpenAL, this is
+  // cheap and done every frame so that the streams don't run dry
+  for(auto stream : update_list) {
+    stream->update();
+  }
+
   static Uint32 lasttime = SDL_GetTicks();
   Uint32 now = SDL_GetTicks();
 
@@ -408,34 +862,40 @@ SoundManager::update()
   lasttime = now;
 
   // update and check for finished sound sources
-  for(SoundSources::iterator i = sources.begin(); i != sources.end(); ) {
-    auto& source = *i;
+  for(Voices::iterator i = voices.begin(); i != voices.end(); ) {
+    auto& source = i->source;
 
     source->update();
 
     if(!source->playing()) {
-      i = sources.erase(i);
+      i = voices.erase(i);
     } else {
       ++i;
     }
   }
-  // check streaming sounds
-  if(music_source) {
-    music_source->update();
+  // upload the sounds decoded in the background, then free the least
+  // recently used buffers now that finished sources released theirs
+  std::vector<std::string> decoded;
+  {
+    std::lock_guard<std::mutex> lock(decoded_mutex);
+    for(const auto& sound : decoded_sounds) {
+      decoded.push_back(sound.first);
+    }
+  }
+  for(const auto& name : decoded) {
+    try {
+      take_decoded(name);
+    } catch(std::exception& e) {
+      log_warning << "Couldn't upload sound " << name << ": " << e.what() << std::endl;
+    }
   }
+  evict_buffers();
 
   if (context)
   {
     alcProcessContext(context);
     check_alc_error("Error while processing audio context: ");
   }
-
-  //run update() for stream_sound_source
-  StreamSoundSources::iterator s = update_list.begin();
-  while( s != update_list.end() ){
-    (*s)->update();
-    ++s;
-  }
 }
 
 ALenum
@@ -17,19 +17,25 @@
 #ifndef HEADER_SUPERTUX_AUDIO_SOUND_MANAGER_HPP
 #define HEADER_SUPERTUX_AUDIO_SOUND_MANAGER_HPP
 
+#include <condition_variable>
+#include <deque>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <al.h>
 #include <alc.h>
 
+#include "audio/sound_buffer_cache.hpp"
 #include "math/vector.hpp"
 #include "util/currenton.hpp"
 
 class SoundFile;
 class SoundSource;
+class StreamDecoder;
 class StreamSoundSource;
 class OpenALSoundSource;
 
@@ -49,15 +55,46 @@ public:
   std::unique_ptr<SoundSource> create_sound_source(const std::string& filename);
   /**
    * Convenience function to simply play a sound at a given position.
+   * The sound is dropped if it already started in this frame or if all
+   * voices are taken by sounds of higher priority, see allocate_voice().
    */
   void play(const std::string& name, const Vector& pos = Vector(-1, -1));
   /**
    * Adds the source to the list of managed sources (= the source gets deleted
-   * when it finished playing)
+   * when it finished playing). Managed sources are voices like the sounds
+   * started by play() and share their limits.
    */
   void manage_source(std::unique_ptr<SoundSource> source);
-  /// preloads a sound, so that you don't get a lag later when playing it
+  /**
+   * Preloads a sound, so that you don't get a lag later when playing it.
+   * The sound is decoded on a background thread, playing it before that
+   * finished waits for the decoder.
+   */
   void preload(const std::string& name);
+  /**
+   * Decodes a sound without touching OpenAL, so that a later preload() or
+   * play() only has to upload it. Can be called from any thread.
+   */
+  void decode(const std::string& name);
+  /// returns true if the sound is already in a buffer
+  bool is_loaded(const std::string& name) const;
+
+  /**
+   * Starts collecting the names of all sounds that are preloaded or
+   * played, used to build the preload manifest of a level while its
+   * sectors are parsed.
+   */
+  void begin_manifest();
+  /// stops collecting sound names and returns the sorted manifest
+  std::vector<std::string> end_manifest();
+  /**
+   * Makes the sounds of the manifest the ones used by the current level:
+   * they are never evicted from the buffer cache and the ones that were
+   * evicted earlier are decoded again in the background.
+   */
+  void set_manifest(const std::vector<std::string>& names);
+
+  const SoundBufferCache::Stats& get_buffer_stats() const { return buffers.get_stats(); }
 
   void set_listener_position(const Vector& position);
   void set_listener_velocity(const Vector& velocity);
@@ -85,13 +122,18 @@ public:
   void update();
 
   /*
-   * Tell soundmanager to call update() for stream_sound_source.
+   * Tell soundmanager to call update() for stream_sound_source and to
+   * decode it ahead on the stream thread.
    */
   void register_for_update( StreamSoundSource* sss );
   /*
    * Unsubscribe from updates for stream_sound_source.
    */
   void remove_from_update( StreamSoundSource* sss );
+  /*
+   * Decode ahead on the stream thread until the decoder is detached.
+   */
+  void start_decode(const std::shared_ptr<StreamDecoder>& decoder);
 
 private:
   friend class OpenALSoundSource;
@@ -99,7 +141,54 @@ private:
 
   /** creates a new sound source, might throw exceptions, never returns NULL */
   std::unique_ptr<OpenALSoundSource> intern_create_sound_source(const std::string& filename);
+  struct DecodedSound
+  {
+    ALenum format;
+    ALsizei rate;
+    std::vector<char> samples;
+  };
+
   static ALuint load_file_into_buffer(SoundFile& file);
+  static std::unique_ptr<DecodedSound> decode_file(SoundFile& file);
+  static ALuint create_buffer(const DecodedSound& sound);
+  /** returns the buffer of a sound decoded by decode(), 0 if there is none */
+  ALuint take_decoded(const std::string& filename);
+  /** queues the sound for the decode thread, starting it if needed */
+  void queue_decode(const std::string& filename);
+  /** waits until the sound isn't queued or decoded in the background anymore */
+  void wait_for_decode(const std::string& filename);
+  void decode_thread_main();
+  /** frees least recently used buffers until the cache is within its budget */
+  void evict_buffers();
+  void record(const std::string& filename);
+  void stream_thread_main();
+
+  /** returns a pooled source, generates a new one if the pool is empty */
+  ALuint acquire_source();
+  /** resets the source and puts it back into the pool */
+  void release_source(ALuint source);
+
+  struct VoiceLimit
+  {
+    VoiceLimit() : max_voices(4), priority(0) {}
+
+    /// number of instances of the sound that may play at the same time
+    int max_voices;
+    /// voices of lower priority are stolen first when all voices are taken
+    int priority;
+  };
+
+  /** reads the voice limits from a supertux-soundinfo file */
+  void load_voice_limits(const std::string& filename);
+  const VoiceLimit& get_voice_limit(const std::string& name) const;
+  /**
+   * Makes room for a new voice of the sound: stops the oldest instance
+   * of the sound when it reached its limit or steals the voice of lowest
+   * priority when all voices are taken. Returns false if the sound
+   * shouldn't be played, because it already started in this frame or
+   * because all voices play sounds of higher priority.
+   */
+  bool allocate_voice(const std::string& name);
   static ALenum get_sample_format(const SoundFile& file);
 
   static void print_openal_version();
@@ -110,14 +199,55 @@ private:
   ALCcontext* context;
   bool sound_enabled;
 
-  typedef std::map<std::string, ALuint> SoundBuffers;
-  SoundBuffers buffers;
-  typedef std::vector<std::unique_ptr<OpenALSoundSource> > SoundSources;
-  SoundSources sources;
+  SoundBufferCache buffers;
+
+  /// sounds decoded by decode() that still have to be uploaded
+  std::map<std::string, std::unique_ptr<DecodedSound> > decoded_sounds;
+  std::mutex decoded_mutex;
+
+  /// background decoding of preloaded sounds, guarded by decoded_mutex
+  std::thread decode_thread;
+  std::condition_variable decode_cond;
+  std::deque<std::string> decode_queue;
+  std::string decode_current;
+  bool decode_quit;
+
+  bool recording_manifest;
+  std::vector<std::string> manifest;
+  /// unused OpenAL sources, allocated up front
+  std::vector<ALuint> free_sources;
+
+  struct Voice
+  {
+    Voice(std::unique_ptr<OpenALSoundSource> source_, const std::string& name_,
+          int priority_, unsigned int frame_);
+
+    std::unique_ptr<OpenALSoundSource> source;
+    std::string name;
+    int priority;
+    /// frame the voice started in, voices are kept oldest first
+    unsigned int frame;
+  };
+
+  typedef std::vector<Voice> Voices;
+  Voices voices;
+  int max_voices;
+  std::map<std::string, VoiceLimit> voice_limits;
+  VoiceLimit default_voice_limit;
+  /// counts the calls of update(), to merge sounds started in one frame
+  unsigned int frame;
 
   typedef std::vector<StreamSoundSource*> StreamSoundSources;
   StreamSoundSources update_list;
 
+  /// decodes the streams ahead, the stream thread copies stream_decoders
+  /// with stream_mutex locked and decodes without holding it
+  std::vector<std::shared_ptr<StreamDecoder> > stream_decoders;
+  std::thread stream_thread;
+  std::mutex stream_mutex;
+  std::condition_variable stream_cond;
+  bool stream_quit;
+
   std::unique_ptr<StreamSoundSource> music_source;
 
   bool music_enabled;
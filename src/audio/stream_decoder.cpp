@@ -0,0 +1,88 @@
+//  SuperTux
+//  Copyright (C) 2018 SuperTux Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "audio/stream_decoder.hpp"
+
+#include <stdexcept>
+
+#include "audio/sound_file.hpp"
+
+StreamDecoder::StreamDecoder(std::unique_ptr<SoundFile> file, size_t fragment_size,
+                             size_t max_fragments, size_t target_fragments, bool looping) :
+  m_file(std::move(file)),
+  m_fragment_size(fragment_size),
+  m_fragments(max_fragments),
+  m_target_fragments(target_fragments),
+  m_looping(looping),
+  m_end_of_file(false),
+  m_detached(false)
+{
+}
+
+StreamDecoder::~StreamDecoder()
+{
+}
+
+void
+StreamDecoder::decode_fragments()
+{
+  try {
+    while(!m_detached && m_fragments.size() < m_target_fragments) {
+      if(!decode_fragment())
+        break;
+    }
+  } catch(std::exception&) {
+    // not logged as this runs on another thread, the stream just ends
+    m_looping = false;
+    m_end_of_file = true;
+  }
+}
+
+bool
+StreamDecoder::decode_fragment()
+{
+  if(m_end_of_file && !m_looping)
+    return false;
+
+  FragmentRing::Fragment* fragment = m_fragments.begin_write();
+  if(!fragment)
+    return false;
+
+  fragment->data.resize(m_fragment_size);
+  size_t bytesread = 0;
+  do {
+    bytesread += m_file->read(fragment->data.data() + bytesread,
+                              m_fragment_size - bytesread);
+    // end of sound file
+    if(bytesread < m_fragment_size) {
+      if(m_looping) {
+        m_file->reset();
+      } else {
+        m_end_of_file = true;
+        break;
+      }
+    }
+  } while(bytesread < m_fragment_size);
+
+  fragment->size = bytesread;
+  if(bytesread == 0)
+    return false;
+
+  m_fragments.end_write();
+  return true;
+}
+
+/* EOF */
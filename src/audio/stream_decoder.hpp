@@ -0,0 +1,81 @@
+//  SuperTux
+//  Copyright (C) 2018 SuperTux Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_AUDIO_STREAM_DECODER_HPP
+#define HEADER_SUPERTUX_AUDIO_STREAM_DECODER_HPP
+
+#include <atomic>
+#include <memory>
+
+#include "audio/fragment_ring.hpp"
+
+class SoundFile;
+
+/**
+ * Decoding side of a StreamSoundSource. The SoundManager's stream
+ * thread holds a shared_ptr to it while decoding, so the source can be
+ * destroyed or switch files without waiting for a decode pass to end,
+ * it only has to detach() the decoder.
+ */
+class StreamDecoder final
+{
+public:
+  StreamDecoder(std::unique_ptr<SoundFile> file, size_t fragment_size,
+                size_t max_fragments, size_t target_fragments, bool looping);
+  ~StreamDecoder();
+
+  /** Decodes fragments until the ring holds target_fragments of them.
+      Called on the stream thread, a broken file just ends the stream. */
+  void decode_fragments();
+
+  /** Decodes a single fragment, returns false if the ring is full or
+      the file has ended */
+  bool decode_fragment();
+
+  /** Reader side of the decoded fragments, see FragmentRing */
+  const FragmentRing::Fragment* begin_read() const { return m_fragments.begin_read(); }
+  void end_read() { m_fragments.end_read(); }
+  size_t get_fragment_count() const { return m_fragments.size(); }
+
+  void set_looping(bool looping) { m_looping = looping; }
+  bool get_looping() const { return m_looping; }
+
+  void set_target_fragments(size_t target) { m_target_fragments = target; }
+
+  bool is_end_of_file() const { return m_end_of_file; }
+
+  /** Tells the stream thread to stop decoding and to drop the decoder */
+  void detach() { m_detached = true; }
+  bool is_detached() const { return m_detached; }
+
+private:
+  std::unique_ptr<SoundFile> m_file;
+  size_t m_fragment_size;
+  FragmentRing m_fragments;
+
+  std::atomic<size_t> m_target_fragments;
+  std::atomic<bool> m_looping;
+  std::atomic<bool> m_end_of_file;
+  std::atomic<bool> m_detached;
+
+private:
+  StreamDecoder(const StreamDecoder&) = delete;
+  StreamDecoder& operator=(const StreamDecoder&) = delete;
+};
+
+#endif
+
+/* EOF */
@@ -16,37 +16,39 @@
 
 #include "audio/sound_file.hpp"
 #include "audio/sound_manager.hpp"
+#include "audio/stream_decoder.hpp"
 #include "audio/stream_sound_source.hpp"
 #include "supertux/globals.hpp"
 #include "util/log.hpp"
 
 StreamSoundSource::StreamSoundSource() :
-  file(),
+  decoder(),
+  format(),
+  rate(),
+  buffers(),
+  free_buffers(),
+  queued_buffers(0),
+  target_fragments(STREAMFRAGMENTS),
+  last_underrun(0),
   fade_state(NoFading),
   fade_start_time(),
   fade_time(),
   looping(false)
 {
-  alGenBuffers(STREAMFRAGMENTS, buffers);
-  try
-  {
-    SoundManager::check_al_error("Couldn't allocate audio buffers: ");
-  }
-  catch(std::exception& e)
-  {
-    log_warning << e.what() << std::endl;
-  }
   //add me to update list
   SoundManager::current()->register_for_update( this );
 }
 
 StreamSoundSource::~StreamSoundSource()
 {
-  //don't update me any longer
+  //don't update me any longer, the stream thread drops the decoder
+  //on its own
   SoundManager::current()->remove_from_update( this );
-  file.reset();
+  if(decoder)
+    decoder->detach();
   stop();
-  alDeleteBuffers(STREAMFRAGMENTS, buffers);
+  if(!buffers.empty())
+    alDeleteBuffers(static_cast<ALsizei>(buffers.size()), buffers.data());
   try
   {
     SoundManager::check_al_error("Couldn't delete audio buffers: ");
@@ -61,14 +63,38 @@ StreamSoundSource::~StreamSoundSource()
 void
 StreamSoundSource::set_sound_file(std::unique_ptr<SoundFile> newfile)
 {
-  file = std::move(newfile);
+  format = SoundManager::get_sample_format(*newfile);
+  rate = static_cast<ALsizei>(newfile->rate);
+
+  // the stream thread may still be decoding the old file, it drops the
+  // old decoder once it notices that it is detached
+  if(decoder)
+    decoder->detach();
+  decoder = std::make_shared<StreamDecoder>(std::move(newfile), STREAMFRAGMENTSIZE,
+                                            MAX_STREAMFRAGMENTS, target_fragments, looping);
+
+  // decode the first fragment right away, so that playing can start
+  // before the stream thread gets to this source
+  decoder->decode_fragment();
+  SoundManager::current()->start_decode(decoder);
+
+  queue_fragments();
+}
 
-  ALint queued;
-  alGetSourcei(source, AL_BUFFERS_QUEUED, &queued);
-  for(size_t i = 0; i < STREAMFRAGMENTS - queued; ++i) {
-    if(fillBufferAndQueue(buffers[i]) == false)
-      break;
-  }
+void
+StreamSoundSource::set_looping(bool looping_)
+{
+  looping = looping_;
+  if(decoder)
+    decoder->set_looping(looping);
+}
+
+void
+StreamSoundSource::set_target_fragments(size_t target)
+{
+  target_fragments = target;
+  if(decoder)
+    decoder->set_target_fragments(target);
 }
 
 void
@@ -82,23 +108,41 @@ StreamSoundSource::update()
     try
     {
       SoundManager::check_al_error("Couldn't unqueue audio buffer: ");
+      free_buffers.push_back(buffer);
+      queued_buffers -= 1;
     }
     catch(std::exception& e)
     {
       log_warning << e.what() << std::endl;
     }
+  }
 
-    if(fillBufferAndQueue(buffer) == false)
-      break;
+  // stop() detaches all buffers from the source
+  ALint queued = 0;
+  alGetSourcei(source, AL_BUFFERS_QUEUED, &queued);
+  if(queued == 0 && queued_buffers > 0) {
+    free_buffers = buffers;
+    queued_buffers = 0;
   }
 
+  queue_fragments();
+
   if(!playing()) {
     if(processed == 0 || !looping)
       return;
 
-    // we might have to restart the source if we had a buffer underrun
-    log_info << "Restarting audio source because of buffer underrun" << std::endl;
+    // we might have to restart the source if we had a buffer underrun,
+    // buffer more from now on so that it doesn't happen again
+    size_t target = target_fragments + 2;
+    set_target_fragments(target < MAX_STREAMFRAGMENTS ? target : MAX_STREAMFRAGMENTS);
+    last_underrun = real_time;
+    log_info << "Restarting audio source because of buffer underrun, now buffering "
+             << target_fragments << " fragments" << std::endl;
     play();
+  } else if(target_fragments > STREAMFRAGMENTS && real_time - last_underrun > 60.0f) {
+    // no underruns for a while, give some of the memory back
+    set_target_fragments(target_fragments - 1);
+    last_underrun = real_time;
   }
 
   if(fade_state == FadingOn || fade_state == FadingResume) {
@@ -131,42 +175,51 @@ StreamSoundSource::set_fading(FadeState state, float fade_time_)
   fade_start_time = real_time;
 }
 
-bool
-StreamSoundSource::fillBufferAndQueue(ALuint buffer)
+void
+StreamSoundSource::queue_fragments()
 {
-  // fill buffer
-  std::unique_ptr<char[]> bufferdata(new char[STREAMFRAGMENTSIZE]);
-  size_t bytesread = 0;
-  do {
-    bytesread += file->read(bufferdata.get() + bytesread,
-                            STREAMFRAGMENTSIZE - bytesread);
-    // end of sound file
-    if(bytesread < STREAMFRAGMENTSIZE) {
-      if(looping)
-        file->reset();
-      else
+  if(!decoder)
+    return;
+
+  while(queued_buffers < target_fragments) {
+    const FragmentRing::Fragment* fragment = decoder->begin_read();
+    if(!fragment)
+      break;
+
+    ALuint buffer;
+    if(free_buffers.empty()) {
+      alGenBuffers(1, &buffer);
+      try
+      {
+        SoundManager::check_al_error("Couldn't allocate audio buffer: ");
+      }
+      catch(std::exception& e)
+      {
+        log_warning << e.what() << std::endl;
         break;
+      }
+      buffers.push_back(buffer);
+    } else {
+      buffer = free_buffers.back();
+      free_buffers.pop_back();
     }
-  } while(bytesread < STREAMFRAGMENTSIZE);
 
-  if(bytesread > 0) {
-    ALenum format = SoundManager::get_sample_format(*file);
     try
     {
-      alBufferData(buffer, format, bufferdata.get(), static_cast<ALsizei>(bytesread), file->rate);
+      alBufferData(buffer, format, fragment->data.data(), static_cast<ALsizei>(fragment->size), rate);
       SoundManager::check_al_error("Couldn't refill audio buffer: ");
 
       alSourceQueueBuffers(source, 1, &buffer);
       SoundManager::check_al_error("Couldn't queue audio buffer: ");
+      queued_buffers += 1;
     }
     catch(std::exception& e)
     {
       log_warning << e.what() << std::endl;
+      free_buffers.push_back(buffer);
     }
+    decoder->end_read();
   }
-
-  // return false if there aren't more buffers to fill
-  return bytesread >= STREAMFRAGMENTSIZE;
 }
 
 /* EOF */
@@ -17,10 +17,19 @@
 #ifndef HEADER_SUPERTUX_AUDIO_STREAM_SOUND_SOURCE_HPP
 #define HEADER_SUPERTUX_AUDIO_STREAM_SOUND_SOURCE_HPP
 
+#include <memory>
+#include <vector>
+
 #include "audio/openal_sound_source.hpp"
 
 class SoundFile;
+class StreamDecoder;
 
+/**
+ * Sound source for music and long sounds. The file is decoded ahead on
+ * the stream thread of the SoundManager by a StreamDecoder, update()
+ * only has to hand finished fragments to OpenAL.
+ */
 class StreamSoundSource : public OpenALSoundSource
 {
 public:
@@ -38,10 +47,7 @@ public:
   }
   void update();
 
-  void set_looping(bool looping_)
-  {
-    looping = looping_;
-  }
+  void set_looping(bool looping_);
   bool get_looping() const
   {
     return looping;
@@ -52,10 +58,26 @@ private:
   static const size_t STREAMFRAGMENTS = 5;
   static const size_t STREAMFRAGMENTSIZE
   = STREAMBUFFERSIZE / STREAMFRAGMENTS;
+  /// upper limit for the fragments buffered after repeated underruns
+  static const size_t MAX_STREAMFRAGMENTS = 16;
+
+  /** queues decoded fragments in OpenAL */
+  void queue_fragments();
+  void set_target_fragments(size_t target);
+
+  /// shared with the stream thread, nullptr until a file is set
+  std::shared_ptr<StreamDecoder> decoder;
+  ALenum format;
+  ALsizei rate;
+
+  /// all buffers of this source, the ones not queued in OpenAL are free
+  std::vector<ALuint> buffers;
+  std::vector<ALuint> free_buffers;
+  size_t queued_buffers;
 
-  bool fillBufferAndQueue(ALuint buffer);
-  std::unique_ptr<SoundFile> file;
-  ALuint buffers[STREAMFRAGMENTS];
+  /// number of fragments kept decoded and queued, grows on buffer underruns
+  size_t target_fragments;
+  float last_underrun;
 
   FadeState fade_state;
   float fade_start_time;
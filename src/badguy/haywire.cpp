@@ -176,8 +176,8 @@ void
 Haywire::start_exploding()
 {
   set_action ((dir == LEFT) ? "ticking-left" : "ticking-right", /* loops = */ -1);
-  walk_left_action = "ticking-left";
-  walk_right_action = "ticking-right";
+  walk_left_action = SpriteAction("ticking-left");
+  walk_right_action = SpriteAction("ticking-right");
   set_walk_speed (EXPLODING_WALK_SPEED);
   time_until_explosion = TIME_EXPLOSION;
   is_exploding = true;
@@ -197,8 +197,8 @@ Haywire::start_exploding()
 void
 Haywire::stop_exploding()
 {
-  walk_left_action = "left";
-  walk_right_action = "right";
+  walk_left_action = SpriteAction("left");
+  walk_right_action = SpriteAction("right");
   set_walk_speed(NORMAL_WALK_SPEED);
   time_until_explosion = 0.0f;
   is_exploding = false;
@@ -68,9 +68,7 @@ Igel::active_update(float elapsed_time)
 
   // check if we see a fire bullet
   auto sector = Sector::current();
-  for (const auto& object : sector->gameobjects) {
-    auto bullet = reinterpret_cast<Bullet*>(object.get());
-    if (!bullet) continue;
+  for (const auto& bullet : sector->get_objects_by_type<Bullet>()) {
     if (bullet->get_type() != FIRE_BONUS) continue;
     if (can_see(*bullet)) wants_to_flee = true;
   }
@@ -292,9 +292,8 @@ Yeti::drop_stalactite()
   if (!player) return;
 
   Sector* sector = Sector::current();
-  for(const auto& obj : sector->gameobjects) {
-    auto stalactite = dynamic_cast<YetiStalactite*>(obj.get());
-    if(stalactite && stalactite->is_hanging()) {
+  for(const auto& stalactite : sector->get_objects_by_type<YetiStalactite>()) {
+    if(stalactite->is_hanging()) {
       if (hit_points >= 3) {
         // drop stalactites within 3 of player, going out with each jump
         float distancex = fabsf(stalactite->get_bbox().get_middle().x - player->get_bbox().get_middle().x);
@@ -20,15 +20,13 @@
 #include "video/surface.hpp"
 
 CloudParticleSystem::CloudParticleSystem() :
-  ParticleSystem(128),
-  cloudimage(Surface::create("images/objects/particles/cloud.png"))
+  ParticleSystem(128)
 {
   init();
 }
 
 CloudParticleSystem::CloudParticleSystem(const ReaderMapping& reader) :
-  ParticleSystem(128),
-  cloudimage(Surface::create("images/objects/particles/cloud.png"))
+  ParticleSystem(128)
 {
   init();
   parse(reader);
@@ -40,17 +38,15 @@ CloudParticleSystem::~CloudParticleSystem()
 
 void CloudParticleSystem::init()
 {
+  textures.push_back(Surface::create("images/objects/particles/cloud.png"));
+
   virtual_width = 2000.0;
 
   // create some random clouds
   for(size_t i=0; i<15; ++i) {
-    auto particle = std::unique_ptr<CloudParticle>(new CloudParticle);
-    particle->pos.x = graphicsRandom.randf(virtual_width);
-    particle->pos.y = graphicsRandom.randf(virtual_height);
-    particle->texture = cloudimage;
-    particle->speed = -graphicsRandom.randf(25.0, 54.0);
-
-    particles.push_back(std::move(particle));
+    Vector pos(graphicsRandom.randf(virtual_width),
+               graphicsRandom.randf(virtual_height));
+    particles.add(pos, 0, -graphicsRandom.randf(25.0, 54.0));
   }
 }
 
@@ -59,12 +55,7 @@ void CloudParticleSystem::update(float elapsed_time)
   if(!enabled)
     return;
 
-  for(auto& particle : particles) {
-    auto cloudParticle = dynamic_cast<CloudParticle*>(particle.get());
-    if (!cloudParticle)
-      continue;
-    cloudParticle->pos.x += cloudParticle->speed * elapsed_time;
-  }
+  move_particles(elapsed_time, 0.0f);
 }
 
 /* EOF */
@@ -45,19 +45,6 @@ public:
     return "images/engine/editor/clouds.png";
   }
 
-private:
-  class CloudParticle : public Particle
-  {
-  public:
-    float speed;
-
-    CloudParticle() :
-      speed()
-    {}
-  };
-
-  SurfacePtr cloudimage;
-
 private:
   CloudParticleSystem(const CloudParticleSystem&);
   CloudParticleSystem& operator=(const CloudParticleSystem&);
@@ -44,22 +44,20 @@ GhostParticleSystem::~GhostParticleSystem()
 
 void GhostParticleSystem::init()
 {
-  ghosts[0] = Surface::create("images/objects/particles/ghost0.png");
-  ghosts[1] = Surface::create("images/objects/particles/ghost1.png");
+  textures.push_back(Surface::create("images/objects/particles/ghost0.png"));
+  textures.push_back(Surface::create("images/objects/particles/ghost1.png"));
 
   virtual_width = static_cast<float>(SCREEN_WIDTH) * 2.0f;
 
   // create two ghosts
   size_t ghostcount = 2;
   for(size_t i=0; i<ghostcount; ++i) {
-    auto particle = std::unique_ptr<GhostParticle>(new GhostParticle);
-    particle->pos.x = graphicsRandom.randf(virtual_width);
-    particle->pos.y = graphicsRandom.randf(static_cast<float>(SCREEN_HEIGHT));
+    Vector pos(graphicsRandom.randf(virtual_width),
+               graphicsRandom.randf(static_cast<float>(SCREEN_HEIGHT)));
     int size = graphicsRandom.rand(2);
-    particle->texture = ghosts[size];
-    particle->speed = graphicsRandom.randf(std::max(50.0f, static_cast<float>(size) * 10.0f),
-                                           180.0f + static_cast<float>(size) * 10.0f);
-    particles.push_back(std::move(particle));
+    float speed = graphicsRandom.randf(std::max(50.0f, static_cast<float>(size) * 10.0f),
+                                       180.0f + static_cast<float>(size) * 10.0f);
+    particles.add(pos, size, speed);
   }
 }
 
@@ -68,13 +66,12 @@ void GhostParticleSystem::update(float elapsed_time)
   if(!enabled)
     return;
 
-  for(const auto& part : particles) {
-    const auto& particle = dynamic_cast<GhostParticle*>(part.get());
-    particle->pos.y -= particle->speed * elapsed_time;
-    particle->pos.x -= particle->speed * elapsed_time;
-    if(particle->pos.y > static_cast<float>(SCREEN_HEIGHT)) {
-      particle->pos.y = fmodf(particle->pos.y , virtual_height);
-      particle->pos.x = graphicsRandom.randf(virtual_width);
+  move_particles(-elapsed_time, -elapsed_time);
+
+  for(size_t i = 0; i < particles.size(); ++i) {
+    if(particles.y[i] > static_cast<float>(SCREEN_HEIGHT)) {
+      particles.y[i] = fmodf(particles.y[i], virtual_height);
+      particles.x[i] = graphicsRandom.randf(virtual_width);
     }
   }
 }
@@ -73,9 +73,7 @@ InfoBlock::hit(Player& player)
     // first hide all other InfoBlocks' messages in same sector
     auto parent = Sector::current();
     if (!parent) return;
-    for (const auto& object : parent->gameobjects) {
-      auto block = dynamic_cast<InfoBlock*>(object.get());
-      if (!block) continue;
+    for (const auto& block : parent->get_objects_by_type<InfoBlock>()) {
       if (block != this) block->hide_message();
     }
 
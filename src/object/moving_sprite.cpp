@@ -143,6 +143,13 @@ MovingSprite::set_action(const std::string& action, int loops)
   set_size(sprite->get_current_hitbox_width(), sprite->get_current_hitbox_height());
 }
 
+void
+MovingSprite::set_action(const SpriteAction& action, int loops)
+{
+  sprite->set_action(action, loops);
+  set_size(sprite->get_current_hitbox_width(), sprite->get_current_hitbox_height());
+}
+
 void
 MovingSprite::set_action_centered(const std::string& action, int loops)
 {
@@ -18,6 +18,7 @@
 #define HEADER_SUPERTUX_OBJECT_MOVING_SPRITE_HPP
 
 #include "object/anchor_point.hpp"
+#include "sprite/sprite_action.hpp"
 #include "sprite/sprite_ptr.hpp"
 #include "supertux/moving_object.hpp"
 #include "video/drawing_context.hpp"
@@ -78,6 +79,7 @@ protected:
   /** set new action for sprite and resize bounding box.  use with
       care as you can easily get stuck when resizing the bounding box. */
   void set_action(const std::string& action, int loops);
+  void set_action(const SpriteAction& action, int loops);
 
   /** set new action for sprite and re-center bounding box.  use with
       care as you can easily get stuck when resizing the bounding
@@ -23,6 +23,7 @@
 #include "util/reader_mapping.hpp"
 #include "util/writer.hpp"
 #include "video/drawing_context.hpp"
+#include "video/surface.hpp"
 #include "video/video_system.hpp"
 #include "video/viewport.hpp"
 
@@ -30,10 +31,12 @@ ParticleSystem::ParticleSystem(float max_particle_size_) :
   ExposedObject<ParticleSystem, scripting::ParticleSystem>(this),
   max_particle_size(max_particle_size_),
   z_pos(LAYER_BACKGROUND1),
+  textures(),
   particles(),
   virtual_width(static_cast<float>(SCREEN_WIDTH) + max_particle_size * 2.0f),
   virtual_height(static_cast<float>(SCREEN_HEIGHT) + max_particle_size * 2.0f),
-  enabled(true)
+  enabled(true),
+  batches()
 {
 }
 
@@ -63,29 +66,97 @@ void ParticleSystem::draw(DrawingContext& context)
   if(!enabled)
     return;
 
-  float scrollx = context.get_translation().x;
-  float scrolly = context.get_translation().y;
+  Vector scroll = context.get_translation();
 
   context.push_transform();
   context.set_translation(Vector(max_particle_size,max_particle_size));
 
-  for(const auto& particle : particles) {
-    // remap x,y coordinates onto screencoordinates
-    Vector pos;
+  draw_particles(context.color(), scroll, true);
 
-    pos.x = fmodf(particle->pos.x - scrollx, virtual_width);
-    if(pos.x < 0) pos.x += virtual_width;
+  context.pop_transform();
+}
 
-    pos.y = fmodf(particle->pos.y - scrolly, virtual_height);
-    if(pos.y < 0) pos.y += virtual_height;
+size_t
+ParticleSystem::ParticleArrays::add(const Vector& pos, int texture_, float speed_, float angle_)
+{
+  x.push_back(pos.x);
+  y.push_back(pos.y);
+  speed.push_back(speed_);
+  angle.push_back(angle_);
+  texture.push_back(texture_);
+  return x.size() - 1;
+}
 
-    //if(pos.x > virtual_width) pos.x -= virtual_width;
-    //if(pos.y > virtual_height) pos.y -= virtual_height;
+void
+ParticleSystem::move_particles(float dx, float dy)
+{
+  const size_t count = particles.size();
+  float* x = particles.x.data();
+  float* y = particles.y.data();
+  const float* speed = particles.speed.data();
+
+  for(size_t i = 0; i < count; ++i) {
+    x[i] += speed[i] * dx;
+    y[i] += speed[i] * dy;
+  }
+}
 
-    context.color().draw_surface(particle->texture, pos, particle->angle, Color(1.0f, 1.0f, 1.0f), Blend(), z_pos);
+void
+ParticleSystem::draw_particles(Canvas& canvas, const Vector& scroll, bool wrap)
+{
+  batches.resize(textures.size());
+  for(auto& batch : batches) {
+    batch.srcrects.clear();
+    batch.dstrects.clear();
+    batch.angles.clear();
+    batch.rotated = false;
   }
 
-  context.pop_transform();
+  const Rectf cliprect = canvas.get_context().get_cliprect();
+
+  for(size_t i = 0; i < particles.size(); ++i) {
+    // remap x,y coordinates onto screencoordinates
+    float x = particles.x[i] - scroll.x;
+    float y = particles.y[i] - scroll.y;
+
+    if(wrap) {
+      x = fmodf(x, virtual_width);
+      if(x < 0) x += virtual_width;
+
+      y = fmodf(y, virtual_height);
+      if(y < 0) y += virtual_height;
+    }
+
+    const int texture = particles.texture[i];
+    const Surface& surface = *textures[texture];
+    const Sizef size(static_cast<float>(surface.get_width()),
+                     static_cast<float>(surface.get_height()));
+
+    if(x > cliprect.get_right() || y > cliprect.get_bottom() ||
+       x + size.width < cliprect.get_left() || y + size.height < cliprect.get_top())
+      continue;
+
+    Batch& batch = batches[texture];
+    batch.srcrects.push_back(Rectf(Vector(0.0f, 0.0f), size));
+    batch.dstrects.push_back(Rectf(Vector(x, y), size));
+    batch.angles.push_back(particles.angle[i]);
+    if(particles.angle[i] != 0.0f)
+      batch.rotated = true;
+  }
+
+  for(size_t i = 0; i < batches.size(); ++i) {
+    const Batch& batch = batches[i];
+    if(batch.dstrects.empty())
+      continue;
+
+    if(batch.rotated) {
+      canvas.draw_surface_batch(textures[i], batch.srcrects, batch.dstrects, batch.angles,
+                                Color(1.0f, 1.0f, 1.0f), z_pos);
+    } else {
+      canvas.draw_surface_batch(textures[i], batch.srcrects, batch.dstrects,
+                                Color(1.0f, 1.0f, 1.0f), z_pos);
+    }
+  }
 }
 
 void
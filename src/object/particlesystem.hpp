@@ -19,12 +19,14 @@
 
 #include <vector>
 
+#include "math/rectf.hpp"
 #include "math/vector.hpp"
 #include "scripting/exposed_object.hpp"
 #include "scripting/particlesystem.hpp"
 #include "supertux/game_object.hpp"
 #include "video/surface_ptr.hpp"
 
+class Canvas;
 class ReaderMapping;
 
 /**
@@ -39,8 +41,9 @@ class ReaderMapping;
  * side.
  *
  * Classes that implement a particle system should subclass from this class,
- * initialize particles in the constructor and move them in the simulate
- * function.
+ * fill textures and particles in the constructor and move the particles in
+ * update(). Per-particle state the base class doesn't know about is kept in
+ * further arrays of the subclass, indexed like the ones in particles.
  */
 class ParticleSystem : public GameObject,
                        public ExposedObject<ParticleSystem, scripting::ParticleSystem>
@@ -66,34 +69,67 @@ public:
   { return z_pos; }
 
 protected:
-  class Particle
+  /** Particle data as parallel arrays with one entry per particle, so
+      that update() and draw() loop over contiguous memory instead of
+      following a pointer per particle */
+  class ParticleArrays
   {
   public:
-    Particle() :
-      pos(),
+    ParticleArrays() :
+      x(),
+      y(),
+      speed(),
       angle(),
       texture()
     {}
 
-    virtual ~Particle()
-    {}
+    size_t size() const { return x.size(); }
+
+    /** Appends a particle and returns its index */
+    size_t add(const Vector& pos, int texture_, float speed_ = 0.0f, float angle_ = 0.0f);
 
-    Vector pos;
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> speed;
     // angle at which to draw particle
-    float angle;
-    SurfacePtr texture;
+    std::vector<float> angle;
+    // index into ParticleSystem::textures
+    std::vector<int> texture;
 
   private:
-    Particle(const Particle&);
-    Particle& operator=(const Particle&);
+    ParticleArrays(const ParticleArrays&) = delete;
+    ParticleArrays& operator=(const ParticleArrays&) = delete;
   };
 
+  /** Moves every particle by its speed times (dx, dy) */
+  void move_particles(float dx, float dy);
+
+  /** Submits one batch per texture, scroll is subtracted from the
+      particle positions, which are wrapped to the virtual rectangle
+      when wrap is set */
+  void draw_particles(Canvas& canvas, const Vector& scroll, bool wrap);
+
   float max_particle_size;
   int z_pos;
-  std::vector<std::unique_ptr<Particle> > particles;
+  std::vector<SurfacePtr> textures;
+  ParticleArrays particles;
   float virtual_width;
   float virtual_height;
   bool enabled;
+
+private:
+  struct Batch
+  {
+    Batch() : srcrects(), dstrects(), angles(), rotated(false) {}
+
+    std::vector<Rectf> srcrects;
+    std::vector<Rectf> dstrects;
+    std::vector<float> angles;
+    bool rotated;
+  };
+
+  // reused between frames to avoid reallocating the rect arrays
+  std::vector<Batch> batches;
 };
 
 #endif
@@ -16,6 +16,9 @@
 
 #include "object/particlesystem_interactive.hpp"
 
+#include <algorithm>
+#include <assert.h>
+
 #include "math/aatriangle.hpp"
 #include "object/tilemap.hpp"
 #include "supertux/collision.hpp"
@@ -30,7 +33,11 @@
 //      Add an option to set rain strength
 //      Fix rain being "respawned" over solid tiles
 ParticleSystem_Interactive::ParticleSystem_Interactive() :
-  ParticleSystem()
+  ParticleSystem(),
+  start_tile_x(),
+  start_tile_y(),
+  end_x(),
+  end_y()
 {
   virtual_width = static_cast<float>(SCREEN_WIDTH);
   virtual_height = static_cast<float>(SCREEN_HEIGHT);
@@ -46,17 +53,11 @@ void ParticleSystem_Interactive::draw(DrawingContext& context)
   if(!enabled)
     return;
 
-  context.push_transform();
-
-  for(auto& particle : particles) {
-    context.color().draw_surface(particle->texture, particle->pos, z_pos);
-  }
-
-  context.pop_transform();
+  draw_particles(context.color(), Vector(0.0f, 0.0f), false);
 }
 
 int
-ParticleSystem_Interactive::collision(Particle* object, const Vector& movement)
+ParticleSystem_Interactive::collision(const Vector& pos, const Vector& movement)
 {
   using namespace collision;
 
@@ -64,18 +65,18 @@ ParticleSystem_Interactive::collision(Particle* object, const Vector& movement)
   float x1, x2;
   float y1, y2;
 
-  x1 = object->pos.x;
+  x1 = pos.x;
   x2 = x1 + 32 + movement.x;
   if (x2 < x1) {
     x1 = x2;
-    x2 = object->pos.x;
+    x2 = pos.x;
   }
 
-  y1 = object->pos.y;
+  y1 = pos.y;
   y2 = y1 + 32 + movement.y;
   if (y2 < y1) {
     y1 = y2;
-    y2 = object->pos.y;
+    y2 = pos.y;
   }
   bool water = false;
 
@@ -139,5 +140,52 @@ ParticleSystem_Interactive::collision(Particle* object, const Vector& movement)
   return 0;
 }
 
+void
+ParticleSystem_Interactive::collision(const std::vector<float>& x, const std::vector<float>& y,
+                                      const std::vector<float>& dx, const std::vector<float>& dy,
+                                      std::vector<int>& result)
+{
+  const size_t count = x.size();
+  assert(y.size() == count && dx.size() == count && dy.size() == count);
+
+  result.assign(count, -1);
+
+  // same tile range as in the single particle version above, computed
+  // for all particles in a branch free loop
+  start_tile_x.resize(count);
+  start_tile_y.resize(count);
+  end_x.resize(count);
+  end_y.resize(count);
+  for(size_t i = 0; i < count; ++i) {
+    const float x1 = std::min(x[i], x[i] + 32 + dx[i]);
+    const float x2 = std::max(x[i], x[i] + 32 + dx[i]);
+    const float y1 = std::min(y[i], y[i] + 32 + dy[i]);
+    const float y2 = std::max(y[i], y[i] + 32 + dy[i]);
+
+    start_tile_x[i] = int(x1-1) / 32;
+    start_tile_y[i] = int(y1-1) / 32;
+    end_x[i] = int(x2+1);
+    end_y[i] = int(y2+1);
+  }
+
+  for(size_t i = 0; i < count; ++i) {
+    bool candidate = false;
+    for(const auto& solids : Sector::current()->solid_tilemaps) {
+      for(int tx = start_tile_x[i]; !candidate && tx*32 < end_x[i]; ++tx) {
+        for(int ty = start_tile_y[i]; ty*32 < end_y[i]; ++ty) {
+          if(solids->get_tile_flags(tx, ty) & (TileMap::FLAG_SOLID | TileMap::FLAG_WATER)) {
+            candidate = true;
+            break;
+          }
+        }
+      }
+      if(candidate)
+        break;
+    }
+
+    if(candidate)
+      result[i] = collision(Vector(x[i], y[i]), Vector(dx[i], dy[i]));
+  }
+}
 
 /* EOF */
@@ -17,6 +17,8 @@
 #ifndef HEADER_SUPERTUX_OBJECT_PARTICLESYSTEM_INTERACTIVE_HPP
 #define HEADER_SUPERTUX_OBJECT_PARTICLESYSTEM_INTERACTIVE_HPP
 
+#include <vector>
+
 #include "object/particlesystem.hpp"
 
 class Vector;
@@ -29,8 +31,8 @@ class Vector;
  * but Interactive ones. Particle systems which need Interactive levels coordinates, such
  * as rain, should be implemented here.
  * Classes that implement a particle system should subclass from this class,
- * initialize particles in the constructor and move them in the simulate
- * function.
+ * fill textures and particles in the constructor and move the particles in
+ * update().
  */
 class ParticleSystem_Interactive : public ParticleSystem
 {
@@ -45,8 +47,23 @@ public:
   }
 
 protected:
-  int collision(Particle* particle, const Vector& movement);
+  int collision(const Vector& pos, const Vector& movement);
+
+  /** Tests all particles in one pass, result[i] is set to what
+      collision() returns for a particle at (x[i], y[i]) moving by
+      (dx[i], dy[i]). Particles that only touch empty tiles are
+      rejected by looking at the tile ids of the solid tilemaps
+      directly, only the remaining ones go through collision(). */
+  void collision(const std::vector<float>& x, const std::vector<float>& y,
+                 const std::vector<float>& dx, const std::vector<float>& dy,
+                 std::vector<int>& result);
 
+private:
+  // tile ranges covered by the particles, reused between calls
+  std::vector<int> start_tile_x;
+  std::vector<int> start_tile_y;
+  std::vector<int> end_x;
+  std::vector<int> end_y;
 };
 
 #endif
@@ -1269,12 +1269,12 @@ Player::draw(DrawingContext& context)
 
   /* Set Tux powerup sprite action */
   if (player_status->bonus == EARTH_BONUS) {
-    powersprite->set_action(sprite->get_action());
-    lightsprite->set_action(sprite->get_action());
+    powersprite->set_action(sprite->get_action_handle());
+    lightsprite->set_action(sprite->get_action_handle());
   } else if (player_status->bonus == AIR_BONUS) {
-    powersprite->set_action(sprite->get_action());
+    powersprite->set_action(sprite->get_action_handle());
   } else if (player_status->bonus == FIRE_BONUS && g_config->christmas_mode) {
-    powersprite->set_action(sprite->get_action());
+    powersprite->set_action(sprite->get_action_handle());
   }
 
   /*
@@ -26,12 +26,18 @@
 #include "video/video_system.hpp"
 #include "video/viewport.hpp"
 
-RainParticleSystem::RainParticleSystem()
+RainParticleSystem::RainParticleSystem() :
+  movement_x(),
+  movement_y(),
+  hits()
 {
   init();
 }
 
-RainParticleSystem::RainParticleSystem(const ReaderMapping& reader)
+RainParticleSystem::RainParticleSystem(const ReaderMapping& reader) :
+  movement_x(),
+  movement_y(),
+  hits()
 {
   init();
   parse(reader);
@@ -43,24 +49,23 @@ RainParticleSystem::~RainParticleSystem()
 
 void RainParticleSystem::init()
 {
-  rainimages[0] = Surface::create("images/objects/particles/rain0.png");
-  rainimages[1] = Surface::create("images/objects/particles/rain1.png");
+  textures.push_back(Surface::create("images/objects/particles/rain0.png"));
+  textures.push_back(Surface::create("images/objects/particles/rain1.png"));
 
   virtual_width = static_cast<float>(SCREEN_WIDTH) * 2.0f;
 
   // create some random raindrops
   size_t raindropcount = size_t(virtual_width/6.0);
   for(size_t i=0; i<raindropcount; ++i) {
-    auto particle = std::unique_ptr<RainParticle>(new RainParticle);
-    particle->pos.x = static_cast<float>(graphicsRandom.rand(int(virtual_width)));
-    particle->pos.y = static_cast<float>(graphicsRandom.rand(int(virtual_height)));
+    Vector pos(static_cast<float>(graphicsRandom.rand(int(virtual_width))),
+               static_cast<float>(graphicsRandom.rand(int(virtual_height))));
     int rainsize = graphicsRandom.rand(2);
-    particle->texture = rainimages[rainsize];
+    float speed;
     do {
-      particle->speed = (static_cast<float>(rainsize) + 1.0f) * 45.0f + graphicsRandom.randf(3.6f);
-    } while(particle->speed < 1);
+      speed = (static_cast<float>(rainsize) + 1.0f) * 45.0f + graphicsRandom.randf(3.6f);
+    } while(speed < 1);
 
-    particles.push_back(std::move(particle));
+    particles.add(pos, rainsize, speed);
   }
 }
 
@@ -69,40 +74,49 @@ void RainParticleSystem::update(float elapsed_time)
   if(!enabled)
     return;
 
-  for(auto& it : particles) {
-    auto particle = dynamic_cast<RainParticle*>(it.get());
-    assert(particle);
-
-    float movement = particle->speed * elapsed_time * Sector::current()->get_gravity();
-    float abs_x = Sector::current()->camera->get_translation().x;
-    float abs_y = Sector::current()->camera->get_translation().y;
-    particle->pos.y += movement;
-    particle->pos.x -= movement;
-    int col = collision(particle, Vector(-movement, movement));
-    if ((particle->pos.y > static_cast<float>(SCREEN_HEIGHT) + abs_y) || (col >= 0)) {
+  const float gravity = Sector::current()->get_gravity();
+  const float abs_x = Sector::current()->camera->get_translation().x;
+  const float abs_y = Sector::current()->camera->get_translation().y;
+
+  move_particles(-elapsed_time * gravity, elapsed_time * gravity);
+
+  const size_t count = particles.size();
+  movement_x.resize(count);
+  movement_y.resize(count);
+  for(size_t i = 0; i < count; ++i) {
+    movement_y[i] = particles.speed[i] * elapsed_time * gravity;
+    movement_x[i] = -movement_y[i];
+  }
+
+  collision(particles.x, particles.y, movement_x, movement_y, hits);
+
+  for(size_t i = 0; i < count; ++i) {
+    Vector pos(particles.x[i], particles.y[i]);
+    int col = hits[i];
+    if ((pos.y > static_cast<float>(SCREEN_HEIGHT) + abs_y) || (col >= 0)) {
       //Create rainsplash
-      if ((particle->pos.y <= static_cast<float>(SCREEN_HEIGHT) + abs_y) && (col >= 1)){
+      if ((pos.y <= static_cast<float>(SCREEN_HEIGHT) + abs_y) && (col >= 1)){
         bool vertical = (col == 2);
         if (!vertical) { //check if collision happened from above
           int splash_x, splash_y; // move outside if statement when
                                   // uncommenting the else statement below.
-          splash_x = int(particle->pos.x);
-          splash_y = int(particle->pos.y) - (int(particle->pos.y) % 32) + 32;
+          splash_x = int(pos.x);
+          splash_y = int(pos.y) - (int(pos.y) % 32) + 32;
           Sector::current()->add_object(std::make_shared<RainSplash>(Vector(static_cast<float>(splash_x), static_cast<float>(splash_y)),
                                                                      vertical));
         }
         // Uncomment the following to display vertical splashes, too
         /* else {
-           splash_x = int(particle->pos.x) - (int(particle->pos.x) % 32) + 32;
-           splash_y = int(particle->pos.y);
+           splash_x = int(pos.x) - (int(pos.x) % 32) + 32;
+           splash_y = int(pos.y);
            Sector::current()->add_object(new RainSplash(Vector(splash_x, splash_y),vertical));
            } */
       }
       int new_x = graphicsRandom.rand(int(virtual_width)) + int(abs_x);
       int new_y = 0;
       //FIXME: Don't move particles over solid tiles
-      particle->pos.x = static_cast<float>(new_x);
-      particle->pos.y = static_cast<float>(new_y);
+      particles.x[i] = static_cast<float>(new_x);
+      particles.y[i] = static_cast<float>(new_y);
     }
   }
 }
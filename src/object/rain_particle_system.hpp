@@ -44,17 +44,10 @@ public:
   }
 
 private:
-  class RainParticle : public Particle
-  {
-  public:
-    float speed;
-
-    RainParticle() :
-      speed()
-    {}
-  };
-
-  SurfacePtr rainimages[2];
+  // per-frame movement and collision results, reused between frames
+  std::vector<float> movement_x;
+  std::vector<float> movement_y;
+  std::vector<int> hits;
 
 private:
   RainParticleSystem(const RainParticleSystem&);
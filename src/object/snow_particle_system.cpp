@@ -37,6 +37,11 @@ static const float WOBBLE_FACTOR = 4 * .005f; //wobble approaches drift_speed by
 }
 
 SnowParticleSystem::SnowParticleSystem() :
+  wobble(),
+  anchorx(),
+  drift_speed(),
+  spin_speed(),
+  flake_size(),
   state(RELEASING),
   timer(),
   gust_onset(0),
@@ -46,6 +51,11 @@ SnowParticleSystem::SnowParticleSystem() :
 }
 
 SnowParticleSystem::SnowParticleSystem(const ReaderMapping& reader) :
+  wobble(),
+  anchorx(),
+  drift_speed(),
+  spin_speed(),
+  flake_size(),
   state(RELEASING),
   timer(),
   gust_onset(0),
@@ -61,9 +71,9 @@ SnowParticleSystem::~SnowParticleSystem()
 
 void SnowParticleSystem::init()
 {
-  snowimages[0] = Surface::create("images/objects/particles/snow2.png");
-  snowimages[1] = Surface::create("images/objects/particles/snow1.png");
-  snowimages[2] = Surface::create("images/objects/particles/snow0.png");
+  textures.push_back(Surface::create("images/objects/particles/snow2.png"));
+  textures.push_back(Surface::create("images/objects/particles/snow1.png"));
+  textures.push_back(Surface::create("images/objects/particles/snow0.png"));
 
   virtual_width = static_cast<float>(SCREEN_WIDTH) * 2.0f;
 
@@ -72,26 +82,25 @@ void SnowParticleSystem::init()
   // create some random snowflakes
   int snowflakecount = static_cast<int>(virtual_width / 10.0f);
   for(int i = 0; i < snowflakecount; ++i) {
-    auto particle = std::unique_ptr<SnowParticle>(new SnowParticle);
     int snowsize = graphicsRandom.rand(3);
 
-    particle->pos.x = graphicsRandom.randf(virtual_width);
-    particle->pos.y = graphicsRandom.randf(static_cast<float>(SCREEN_HEIGHT));
-    particle->anchorx = particle->pos.x + (graphicsRandom.randf(-0.5, 0.5) * 16);
+    Vector pos(graphicsRandom.randf(virtual_width),
+               graphicsRandom.randf(static_cast<float>(SCREEN_HEIGHT)));
+    anchorx.push_back(pos.x + (graphicsRandom.randf(-0.5, 0.5) * 16));
     // drift will change with wind gusts
-    particle->drift_speed = graphicsRandom.randf(-0.5f, 0.5f) * 0.3f;
-    particle->wobble = 0.0;
+    drift_speed.push_back(graphicsRandom.randf(-0.5f, 0.5f) * 0.3f);
+    wobble.push_back(0.0f);
 
-    particle->texture = snowimages[snowsize];
-    particle->flake_size = static_cast<int>(powf(static_cast<float>(snowsize) + 3.0f, 4.0f)); // since it ranges from 0 to 2
+    // since it ranges from 0 to 2
+    flake_size.push_back(static_cast<float>(static_cast<int>(powf(static_cast<float>(snowsize) + 3.0f, 4.0f))));
 
-    particle->speed = 6.32f * (1.0f + (2.0f - static_cast<float>(snowsize)) / 2.0f + graphicsRandom.randf(1.8f));
+    float speed = 6.32f * (1.0f + (2.0f - static_cast<float>(snowsize)) / 2.0f + graphicsRandom.randf(1.8f));
 
     // Spinning
-    particle->angle = graphicsRandom.randf(360.0);
-    particle->spin_speed = graphicsRandom.randf(-SNOW::SPIN_SPEED,SNOW::SPIN_SPEED);
+    float angle = graphicsRandom.randf(360.0);
+    spin_speed.push_back(graphicsRandom.randf(-SNOW::SPIN_SPEED,SNOW::SPIN_SPEED));
 
-    particles.push_back(std::move(particle));
+    particles.add(pos, snowsize, speed, angle);
   }
 }
 
@@ -137,26 +146,27 @@ void SnowParticleSystem::update(float elapsed_time)
 
   float sq_g = sqrtf(Sector::current()->get_gravity());
 
-  for(auto& part : particles) {
-    auto particle = dynamic_cast<SnowParticle*>(part.get());
-    if(!particle)
-      continue;
+  const size_t count = particles.size();
 
-    float anchor_delta;
+  // Falling
+  move_particles(0.0f, elapsed_time * sq_g);
 
-    // Falling
-    particle->pos.y += particle->speed * elapsed_time * sq_g;
+  // Spinning
+  for(size_t i = 0; i < count; ++i) {
+    particles.angle[i] = fmodf(particles.angle[i] + spin_speed[i] * elapsed_time, 360.0f);
+  }
+
+  // the random jitter keeps this loop scalar, it is split off from the
+  // loops above so those stay plain arithmetic over the arrays
+  for(size_t i = 0; i < count; ++i) {
     // Drifting (speed approaches wind at a rate dependent on flake size)
-    particle->drift_speed += (gust_current_velocity - particle->drift_speed) / static_cast<float>(particle->flake_size) + graphicsRandom.randf(-SNOW::EPSILON, SNOW::EPSILON);
-    particle->anchorx += particle->drift_speed * elapsed_time;
+    drift_speed[i] += (gust_current_velocity - drift_speed[i]) / flake_size[i] + graphicsRandom.randf(-SNOW::EPSILON, SNOW::EPSILON);
+    anchorx[i] += drift_speed[i] * elapsed_time;
     // Wobbling (particle approaches anchorx)
-    particle->pos.x += particle->wobble * elapsed_time * sq_g;
-    anchor_delta = (particle->anchorx - particle->pos.x);
-    particle->wobble += (SNOW::WOBBLE_FACTOR * anchor_delta) + graphicsRandom.randf(-SNOW::EPSILON, SNOW::EPSILON);
-    particle->wobble *= SNOW::WOBBLE_DECAY;
-    // Spinning
-    particle->angle += particle->spin_speed * elapsed_time;
-    particle->angle = fmodf(particle->angle, 360.0);
+    particles.x[i] += wobble[i] * elapsed_time * sq_g;
+    float anchor_delta = (anchorx[i] - particles.x[i]);
+    wobble[i] += (SNOW::WOBBLE_FACTOR * anchor_delta) + graphicsRandom.randf(-SNOW::EPSILON, SNOW::EPSILON);
+    wobble[i] *= SNOW::WOBBLE_DECAY;
   }
 }
 
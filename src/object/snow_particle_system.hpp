@@ -46,29 +46,16 @@ public:
   }
 
 private:
-  class SnowParticle : public Particle
-  {
-  public:
-    float speed;
-    float wobble;
-    float anchorx;
-    float drift_speed;
-
-    // Turning speed
-    float spin_speed;
-
-    // for inertia
-    unsigned int flake_size;
-
-    SnowParticle() :
-      speed(),
-      wobble(),
-      anchorx(),
-      drift_speed(),
-      spin_speed(),
-      flake_size()
-    {}
-  };
+  // per-particle state in addition to ParticleSystem::particles
+  std::vector<float> wobble;
+  std::vector<float> anchorx;
+  std::vector<float> drift_speed;
+
+  // Turning speed
+  std::vector<float> spin_speed;
+
+  // for inertia
+  std::vector<float> flake_size;
 
   // Wind is simulated in discrete "gusts"
 
@@ -92,8 +79,6 @@ private:
   // Current blowing velocity of gust
         gust_current_velocity;
 
-  SurfacePtr snowimages[3];
-
 private:
   SnowParticleSystem(const SnowParticleSystem&);
   SnowParticleSystem& operator=(const SnowParticleSystem&);
@@ -29,13 +29,38 @@
 #include "util/writer.hpp"
 #include "video/drawing_context.hpp"
 #include "video/surface.hpp"
+#include "video/vertex_buffer.hpp"
+#include "video/video_system.hpp"
+
+namespace {
+
+uint8_t get_flags(const Tile* tile)
+{
+  if(!tile)
+    return 0;
+
+  uint32_t attributes = tile->getAttributes();
+  uint8_t flags = 0;
+  if(attributes)                   flags |= TileMap::FLAG_ATTRIBUTES;
+  if(attributes & Tile::SOLID)     flags |= TileMap::FLAG_SOLID;
+  if(attributes & Tile::UNISOLID)  flags |= TileMap::FLAG_UNISOLID;
+  if(attributes & Tile::SLOPE)     flags |= TileMap::FLAG_SLOPE;
+  if(attributes & Tile::ICE)       flags |= TileMap::FLAG_ICE;
+  if(attributes & Tile::WATER)     flags |= TileMap::FLAG_WATER;
+  return flags;
+}
+
+} // namespace
 
 TileMap::TileMap(const TileSet *new_tileset) :
   ExposedObject<TileMap, scripting::TileMap>(this),
   PathObject(),
   editor_active(true),
   tileset(new_tileset),
+  sector(),
   tiles(),
+  tile_flags(),
+  chunks(),
   real_solid(false),
   effective_solid(false),
   speed_x(1),
@@ -68,7 +93,10 @@ TileMap::TileMap(const TileSet *tileset_, const ReaderMapping& reader) :
   PathObject(),
   editor_active(true),
   tileset(tileset_),
+  sector(),
   tiles(),
+  tile_flags(),
+  chunks(),
   real_solid(false),
   effective_solid(false),
   speed_x(1),
@@ -165,6 +193,8 @@ TileMap::TileMap(const TileSet *tileset_, const ReaderMapping& reader) :
 
     tileset->get(tile);
   }
+  update_tile_flags();
+  invalidate_chunks();
 
   if(empty)
   {
@@ -248,6 +278,9 @@ TileMap::get_settings() {
 
 void
 TileMap::after_editor_set() {
+  // the "solid" option writes real_solid directly
+  update_effective_solid();
+
   if ((new_size_x != width || new_size_y != height ||
       new_offset_x || new_offset_y) &&
       new_size_x > 0 && new_size_y > 0) {
@@ -338,31 +371,46 @@ TileMap::draw(DrawingContext& context)
 
   Rectf draw_rect = context.get_cliprect();
   Rect t_draw_rect = get_tiles_overlapping(draw_rect);
-  Vector start = get_tile_position(t_draw_rect.left, t_draw_rect.top);
 
-  Vector pos;
-  int tx, ty;
+  Canvas& canvas = context.get_canvas(draw_target);
+  DrawingEffect effect = context.transform().drawing_effect;
 
   std::unordered_map<SurfacePtr, std::tuple<std::vector<Rectf>, std::vector<Rectf>>> batches;
 
-  for(pos.x = start.x, tx = t_draw_rect.left; tx < t_draw_rect.right; pos.x += 32, ++tx) {
-    for(pos.y = start.y, ty = t_draw_rect.top; ty < t_draw_rect.bottom; pos.y += 32, ++ty) {
-      int index = ty*width + tx;
-      assert (index >= 0);
-      assert (index < (width * height));
+  // static tiles come from the per-chunk vertex buffers, only animated
+  // tiles are collected into batches every frame
+  int chunks_width = (width + CHUNK_SIZE - 1) / CHUNK_SIZE;
+  int cx1 = t_draw_rect.left / CHUNK_SIZE;
+  int cy1 = t_draw_rect.top / CHUNK_SIZE;
+  int cx2 = (t_draw_rect.right + CHUNK_SIZE - 1) / CHUNK_SIZE;
+  int cy2 = (t_draw_rect.bottom + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+  for(int cy = cy1; cy < cy2; ++cy) {
+    for(int cx = cx1; cx < cx2; ++cx) {
+      Chunk& chunk = chunks[cy * chunks_width + cx];
+      if (chunk.dirty || chunk.effect != effect) {
+        update_chunk(chunk, cx, cy, effect);
+      }
 
-      if (tiles[index] == 0) continue;
-      const Tile* tile = tileset->get(tiles[index]);
-      assert(tile != 0);
+      for(const auto& buffer : chunk.buffers) {
+        canvas.draw_vertex_buffer(buffer.first, *buffer.second, offset, current_tint, z_pos);
+      }
 
-      const SurfacePtr& surface = tile->get_current_surface();
-      std::get<0>(batches[surface]).push_back(Rectf(0, 0, 32, 32));
-      std::get<1>(batches[surface]).push_back(Rectf(pos, Sizef(32, 32)));
+      for(const auto& index : chunk.animated) {
+        int tx = index % width;
+        int ty = index / width;
+        if (tx < t_draw_rect.left || tx >= t_draw_rect.right ||
+            ty < t_draw_rect.top || ty >= t_draw_rect.bottom)
+          continue;
+
+        const Tile* tile = tileset->get(tiles[index]);
+        const SurfacePtr& surface = tile->get_current_surface();
+        std::get<0>(batches[surface]).push_back(Rectf(0, 0, 32, 32));
+        std::get<1>(batches[surface]).push_back(Rectf(get_tile_position(tx, ty), Sizef(32, 32)));
+      }
     }
   }
 
-  Canvas& canvas = context.get_canvas(draw_target);
-
   for(const auto& it : batches)
   {
     const SurfacePtr& surface = it.first;
@@ -421,6 +469,8 @@ TileMap::set(int newwidth, int newheight, const std::vector<unsigned int>&newt,
   // make sure all tiles are loaded
   for(const auto& tile : tiles)
     tileset->get(tile);
+  update_tile_flags();
+  invalidate_chunks();
 }
 
 void
@@ -471,6 +521,9 @@ TileMap::resize(int new_width, int new_height, int fill_id,
       }
     }
   }
+
+  update_tile_flags();
+  invalidate_chunks();
 }
 
 void TileMap::resize(const Size& newsize, const Size& resize_offset) {
@@ -534,6 +587,10 @@ TileMap::change(int x, int y, uint32_t newtile)
 {
   assert(x >= 0 && x < width && y >= 0 && y < height);
   tiles[y*width + x] = newtile;
+  tile_flags[y*width + x] = get_flags(tileset->get(newtile));
+
+  int chunks_width = (width + CHUNK_SIZE - 1) / CHUNK_SIZE;
+  chunks[(y / CHUNK_SIZE) * chunks_width + (x / CHUNK_SIZE)].dirty = true;
 }
 
 void
@@ -603,18 +660,104 @@ TileMap::move_by(const Vector& shift)
 void
 TileMap::update_effective_solid()
 {
+  bool was_solid = effective_solid;
+
   if (!real_solid)
     effective_solid = false;
   else if (effective_solid && (current_alpha < .25))
     effective_solid = false;
   else if (!effective_solid && (current_alpha >= .75))
     effective_solid = true;
+
+  if (sector && effective_solid != was_solid)
+    sector->on_tilemap_solidity_change(this);
 }
 
 void
 TileMap::set_tileset(const TileSet* new_tileset)
 {
   tileset = new_tileset;
+  update_tile_flags();
+  invalidate_chunks();
+}
+
+void
+TileMap::invalidate_chunks()
+{
+  int chunks_width = (width + CHUNK_SIZE - 1) / CHUNK_SIZE;
+  int chunks_height = (height + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+  chunks.clear();
+  chunks.resize(chunks_width * chunks_height);
+}
+
+void
+TileMap::update_chunk(Chunk& chunk, int cx, int cy, DrawingEffect effect)
+{
+  std::unordered_map<SurfacePtr, std::tuple<std::vector<Rectf>, std::vector<Rectf>>> quads;
+
+  chunk.animated.clear();
+
+  int x_end = std::min(width, (cx + 1) * CHUNK_SIZE);
+  int y_end = std::min(height, (cy + 1) * CHUNK_SIZE);
+  for(int ty = cy * CHUNK_SIZE; ty < y_end; ++ty) {
+    for(int tx = cx * CHUNK_SIZE; tx < x_end; ++tx) {
+      int index = ty*width + tx;
+      if (tiles[index] == 0) continue;
+      const Tile* tile = tileset->get(tiles[index]);
+      assert(tile != 0);
+
+      if (tile->is_animated()) {
+        chunk.animated.push_back(index);
+        continue;
+      }
+
+      const SurfacePtr& surface = tile->get_current_surface();
+      if (!surface) continue;
+      std::get<0>(quads[surface]).push_back(Rectf(surface->get_position(), Sizef(32, 32)));
+      std::get<1>(quads[surface]).push_back(Rectf(Vector(static_cast<float>(tx * 32),
+                                                         static_cast<float>(ty * 32)),
+                                                  Sizef(32, 32)));
+    }
+  }
+
+  // reuse the existing buffers, most chunk updates come from change()
+  // and don't alter the set of surfaces much
+  std::vector<std::unique_ptr<VertexBuffer> > unused;
+  for(auto& buffer : chunk.buffers) {
+    unused.push_back(std::move(buffer.second));
+  }
+  chunk.buffers.clear();
+
+  for(const auto& it : quads) {
+    const SurfacePtr& surface = it.first;
+
+    std::unique_ptr<VertexBuffer> buffer;
+    if (unused.empty()) {
+      buffer = VideoSystem::current()->new_vertex_buffer();
+    } else {
+      buffer = std::move(unused.back());
+      unused.pop_back();
+    }
+
+    DrawingEffect surface_effect = surface->get_flipx() ?
+      static_cast<DrawingEffect>(effect ^ HORIZONTAL_FLIP) : effect;
+    buffer->set_quads(*surface->get_texture(), std::get<0>(it.second), std::get<1>(it.second),
+                      surface_effect);
+    chunk.buffers.push_back(std::make_pair(surface, std::move(buffer)));
+  }
+
+  chunk.effect = effect;
+  chunk.dirty = false;
+}
+
+void
+TileMap::update_tile_flags()
+{
+  tile_flags.resize(tiles.size());
+  for(size_t i = 0; i < tiles.size(); ++i) {
+    tile_flags[i] = get_flags(tileset->get(tiles[i]));
+  }
 }
 
 /* EOF */
@@ -18,6 +18,7 @@
 #define HEADER_SUPERTUX_OBJECT_TILEMAP_HPP
 
 #include <algorithm>
+#include <memory>
 
 #include "math/rect.hpp"
 #include "math/rectf.hpp"
@@ -30,8 +31,11 @@
 #include "video/color.hpp"
 #include "video/drawing_effect.hpp"
 #include "video/drawing_target.hpp"
+#include "video/surface_ptr.hpp"
+#include "video/vertex_buffer.hpp"
 
 class DrawingContext;
+class Sector;
 class Tile;
 class TileSet;
 
@@ -42,6 +46,18 @@ class TileMap : public GameObject,
                 public ExposedObject<TileMap, scripting::TileMap>,
                 public PathObject
 {
+public:
+  /** Bits of the per-tile summary of Tile::getAttributes(), see get_tile_flags() */
+  enum {
+    FLAG_SOLID      = 0x01,
+    FLAG_UNISOLID   = 0x02,
+    FLAG_SLOPE      = 0x04,
+    /** set for every tile with non-zero attributes */
+    FLAG_ATTRIBUTES = 0x08,
+    FLAG_ICE        = 0x10,
+    FLAG_WATER      = 0x20
+  };
+
 public:
   TileMap(const TileSet *tileset);
   TileMap(const TileSet *tileset, const ReaderMapping& reader);
@@ -143,6 +159,15 @@ public:
   /// returns tile at position pos (in world coordinates)
   uint32_t get_tile_id_at(const Vector& pos) const;
 
+  /** returns the FLAG_* summary of the tile in row y and column x, this
+      allows collision queries to skip empty tiles without a tileset lookup */
+  uint8_t get_tile_flags(int x, int y) const
+  {
+    if(x < 0 || x >= width || y < 0 || y >= height)
+      return 0;
+    return tile_flags[y*width + x];
+  }
+
   void change(int x, int y, uint32_t newtile);
 
   void change_at(const Vector& pos, uint32_t newtile);
@@ -194,12 +219,40 @@ public:
 
   void set_tileset(const TileSet* new_tileset);
 
+  /** Sector that gets notified when the solidity of this tilemap changes */
+  void set_sector(Sector* sector_)
+  { sector = sector_; }
+
 private:
   const TileSet *tileset;
+  Sector* sector;
 
   typedef std::vector<uint32_t> Tiles;
   Tiles tiles;
 
+  /** FLAG_* summary for every entry in tiles, kept in sync by change() */
+  typedef std::vector<uint8_t> TileFlags;
+  TileFlags tile_flags;
+  void update_tile_flags();
+
+  /** The static tiles of a CHUNK_SIZE x CHUNK_SIZE block of the map,
+      uploaded once per surface and redrawn until a tile changes */
+  struct Chunk
+  {
+    Chunk() : dirty(true), effect(NO_EFFECT), buffers(), animated() {}
+
+    bool dirty;
+    /** drawing effect the buffers were built with */
+    DrawingEffect effect;
+    std::vector<std::pair<SurfacePtr, std::unique_ptr<VertexBuffer> > > buffers;
+    /** indices into tiles of animated tiles, these are drawn per frame */
+    std::vector<int> animated;
+  };
+  static const int CHUNK_SIZE = 16;
+  std::vector<Chunk> chunks;
+  void invalidate_chunks();
+  void update_chunk(Chunk& chunk, int cx, int cy, DrawingEffect effect);
+
   /* read solid: In *general*, is this a solid layer?
    * effective solid: is the layer *currently* solid? A generally solid layer
    * may be not solid when its alpha is low.
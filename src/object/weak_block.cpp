@@ -197,9 +197,7 @@ WeakBlock::spreadHit()
       log_debug << "no current sector" << std::endl;
       return;
     }
-    for(const auto& i : sector->gameobjects) {
-      auto wb = dynamic_cast<WeakBlock*>(i.get());
-      if (!wb) continue;
+    for(const auto& wb : sector->get_objects_by_type<WeakBlock>()) {
       if (wb == this) continue;
       if (wb->state != STATE_NORMAL) continue;
       float dx = fabsf(wb->get_pos().x - bbox.p1.x);
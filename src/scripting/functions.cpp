@@ -27,6 +27,7 @@
 #include "supertux/game_manager.hpp"
 #include "supertux/game_session.hpp"
 #include "supertux/gameconfig.hpp"
+#include "supertux/loading_screen.hpp"
 #include "supertux/screen_manager.hpp"
 #include "supertux/sector.hpp"
 #include "supertux/shrinkfade.hpp"
@@ -127,7 +128,12 @@ void load_worldmap(const std::string& filename)
   }
   else
   {
-    ScreenManager::current()->push_screen(std::unique_ptr<Screen>(new WorldMap(filename, WorldMap::current()->get_savegame())));
+    Savegame& savegame = WorldMap::current()->get_savegame();
+    ScreenManager::current()->push_screen(std::unique_ptr<Screen>(new LoadingScreen(
+      filename,
+      [filename, &savegame](const ReaderDocument* doc) {
+        return std::unique_ptr<Screen>(new WorldMap(filename, savegame, "", doc));
+      })));
   }
 }
 
@@ -144,7 +150,12 @@ void load_level(const std::string& filename)
   }
   else
   {
-    ScreenManager::current()->push_screen(std::unique_ptr<Screen>(new GameSession(filename, GameSession::current()->get_savegame())));
+    Savegame& savegame = GameSession::current()->get_savegame();
+    ScreenManager::current()->push_screen(std::unique_ptr<Screen>(new LoadingScreen(
+      filename,
+      [filename, &savegame](const ReaderDocument* doc) {
+        return std::unique_ptr<Screen>(new GameSession(filename, savegame, NULL, doc));
+      })));
   }
 }
 
@@ -34,7 +34,7 @@ Sprite::Sprite(SpriteData& newdata) :
   action(data.get_action("normal"))
 {
   if(!action)
-    action = data.actions.begin()->second.get();
+    action = data.actions.front().get();
   last_ticks = game_time;
 }
 
@@ -69,6 +69,27 @@ Sprite::set_action(const std::string& name, int loops)
     return;
   }
 
+  change_action(newaction, loops);
+}
+
+void
+Sprite::set_action(const SpriteAction& handle, int loops)
+{
+  if(action && action->handle == handle)
+    return;
+
+  const SpriteData::Action* newaction = data.get_action(handle);
+  if(!newaction) {
+    log_debug << "Action '" << handle.get_name() << "' not found." << std::endl;
+    return;
+  }
+
+  change_action(newaction, loops);
+}
+
+void
+Sprite::change_action(const SpriteData::Action* newaction, int loops)
+{
   action = newaction;
   // If the new action has a loops property,
   // we prefer that over the parameter.
@@ -89,6 +110,27 @@ Sprite::set_action_continued(const std::string& name)
     return;
   }
 
+  change_action_continued(newaction);
+}
+
+void
+Sprite::set_action_continued(const SpriteAction& handle)
+{
+  if(action && action->handle == handle)
+    return;
+
+  const SpriteData::Action* newaction = data.get_action(handle);
+  if(!newaction) {
+    log_debug << "Action '" << handle.get_name() << "' not found." << std::endl;
+    return;
+  }
+
+  change_action_continued(newaction);
+}
+
+void
+Sprite::change_action_continued(const SpriteData::Action* newaction)
+{
   action = newaction;
   update();
 }
@@ -135,17 +177,13 @@ Sprite::draw(Canvas& canvas, const Vector& pos, int layer,
   assert(action != 0);
   update();
 
-
-  DrawingContext& context = canvas.get_context();
-  context.push_transform();
-  context.set_drawing_effect(context.get_drawing_effect() ^ effect);
   canvas.draw_surface(action->surfaces[frameidx],
                       pos - Vector(action->x_offset, action->y_offset),
                       angle,
                       color,
                       blend,
-                      layer + action->z_order);
-  context.pop_transform();
+                      layer + action->z_order,
+                      effect);
 }
 
 void
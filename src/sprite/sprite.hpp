@@ -38,9 +38,11 @@ public:
 
   /** Set action (or state) */
   void set_action(const std::string& name, int loops = -1);
+  void set_action(const SpriteAction& action, int loops = -1);
 
   /** Set action (or state), but keep current frame number, loop counter, etc. */
   void set_action_continued(const std::string& name);
+  void set_action_continued(const SpriteAction& action);
 
   /** Set number of animation cycles until animation stops */
   void set_animation_loops(int loops = -1)
@@ -63,6 +65,9 @@ public:
   /** Get current action name */
   const std::string& get_action() const
   { return action->name; }
+  /** Get current action as handle, cheaper to pass on than the name */
+  const SpriteAction& get_action_handle() const
+  { return action->handle; }
 
   int get_width() const;
   int get_height() const;
@@ -111,9 +116,15 @@ public:
   {
     return (data.get_action(name) != NULL);
   }
+  bool has_action (const SpriteAction& action_) const
+  {
+    return (data.get_action(action_) != NULL);
+  }
 
 private:
   void update();
+  void change_action(const SpriteData::Action* newaction, int loops);
+  void change_action_continued(const SpriteData::Action* newaction);
 
   SpriteData& data;
 
@@ -0,0 +1,74 @@
+//  SuperTux
+//  Copyright (C) 2018 SuperTux Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "sprite/sprite_action.hpp"
+
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+namespace {
+
+struct ActionNames
+{
+  ActionNames() : mutex(), ids(), names() {}
+
+  /// sprites are only loaded on the main thread today, the lock keeps
+  /// that from being a hidden requirement
+  std::mutex mutex;
+  std::unordered_map<std::string, int> ids;
+  /// a deque, so that growing it doesn't move the names get_name()
+  /// handed out references to
+  std::deque<std::string> names;
+};
+
+ActionNames& get_action_names()
+{
+  static ActionNames names;
+  return names;
+}
+
+} // namespace
+
+int
+SpriteAction::intern(const std::string& name)
+{
+  ActionNames& names = get_action_names();
+  std::lock_guard<std::mutex> lock(names.mutex);
+  auto it = names.ids.find(name);
+  if (it != names.ids.end())
+    return it->second;
+
+  int id = static_cast<int>(names.names.size());
+  names.ids[name] = id;
+  names.names.push_back(name);
+  return id;
+}
+
+const std::string&
+SpriteAction::get_name() const
+{
+  static const std::string empty;
+  if (m_id < 0)
+    return empty;
+
+  ActionNames& names = get_action_names();
+  std::lock_guard<std::mutex> lock(names.mutex);
+  return names.names[m_id];
+}
+
+/* EOF */
@@ -0,0 +1,53 @@
+//  SuperTux
+//  Copyright (C) 2018 SuperTux Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef HEADER_SUPERTUX_SPRITE_SPRITE_ACTION_HPP
+#define HEADER_SUPERTUX_SPRITE_SPRITE_ACTION_HPP
+
+#include <string>
+
+/**
+ * Pre-resolved sprite action name. Resolving the name once and
+ * keeping the SpriteAction around turns Sprite::set_action() into an
+ * integer search instead of a string lookup. Names are interned
+ * globally, so the same SpriteAction works with every sprite. Interned
+ * names never move, so get_name() can hand out references.
+ */
+class SpriteAction final
+{
+public:
+  /** An action no sprite has */
+  SpriteAction() : m_id(-1) {}
+  explicit SpriteAction(const std::string& name) : m_id(intern(name)) {}
+
+  int get_id() const { return m_id; }
+  /** The returned reference stays valid for the lifetime of the program */
+  const std::string& get_name() const;
+
+  bool operator==(const SpriteAction& rhs) const { return m_id == rhs.m_id; }
+  bool operator!=(const SpriteAction& rhs) const { return m_id != rhs.m_id; }
+
+private:
+  static int intern(const std::string& name);
+
+private:
+  int m_id;
+};
+
+#endif
+
+/* EOF */
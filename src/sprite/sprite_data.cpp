@@ -26,6 +26,7 @@
 
 SpriteData::Action::Action() :
   name(),
+  handle(),
   x_offset(0),
   y_offset(0),
   hitbox_w(0),
@@ -40,6 +41,7 @@ SpriteData::Action::Action() :
 
 SpriteData::SpriteData(const ReaderMapping& lisp, const std::string& basedir) :
   actions(),
+  action_table(),
   name()
 {
   auto iter = lisp.get_iter();
@@ -54,6 +56,12 @@ SpriteData::SpriteData(const ReaderMapping& lisp, const std::string& basedir) :
   }
   if(actions.empty())
     throw std::runtime_error("Error: Sprite without actions.");
+
+  action_table.reserve(actions.size());
+  for(const auto& action : actions) {
+    action_table.push_back(std::make_pair(action->handle.get_id(), action.get()));
+  }
+  std::sort(action_table.begin(), action_table.end());
 }
 
 void
@@ -132,17 +140,43 @@ SpriteData::parse_action(const ReaderMapping& lisp, const std::string& basedir)
       if (action->hitbox_h < 1) action->hitbox_h = max_h - action->y_offset;
     }
   }
-  actions[action->name] = std::move(action);
+  action->handle = SpriteAction(action->name);
+
+  auto i = std::lower_bound(actions.begin(), actions.end(), action->name,
+                            [](const std::unique_ptr<Action>& lhs, const std::string& rhs) {
+                              return lhs->name < rhs;
+                            });
+  if(i != actions.end() && (*i)->name == action->name) {
+    *i = std::move(action);
+  } else {
+    actions.insert(i, std::move(action));
+  }
 }
 
 const SpriteData::Action*
 SpriteData::get_action(const std::string& act) const
 {
-  Actions::const_iterator i = actions.find(act);
-  if(i == actions.end()) {
+  auto i = std::lower_bound(actions.begin(), actions.end(), act,
+                            [](const std::unique_ptr<Action>& lhs, const std::string& rhs) {
+                              return lhs->name < rhs;
+                            });
+  if(i == actions.end() || (*i)->name != act) {
+    return nullptr;
+  }
+  return i->get();
+}
+
+const SpriteData::Action*
+SpriteData::get_action(const SpriteAction& act) const
+{
+  auto i = std::lower_bound(action_table.begin(), action_table.end(), act.get_id(),
+                            [](const std::pair<int, const Action*>& lhs, int rhs) {
+                              return lhs.first < rhs;
+                            });
+  if(i == action_table.end() || i->first != act.get_id()) {
     return nullptr;
   }
-  return i->second.get();
+  return i->second;
 }
 
 /* EOF */
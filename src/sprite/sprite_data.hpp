@@ -17,10 +17,11 @@
 #ifndef HEADER_SUPERTUX_SPRITE_SPRITE_DATA_HPP
 #define HEADER_SUPERTUX_SPRITE_SPRITE_DATA_HPP
 
-#include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "sprite/sprite_action.hpp"
 #include "video/surface_ptr.hpp"
 
 class ReaderMapping;
@@ -44,6 +45,7 @@ private:
     Action();
 
     std::string name;
+    SpriteAction handle;
 
     /** Position correction */
     float x_offset;
@@ -71,13 +73,18 @@ private:
     std::vector<SurfacePtr> surfaces;
   };
 
-  typedef std::map <std::string, std::unique_ptr<Action> > Actions;
+  /** sorted by name */
+  typedef std::vector<std::unique_ptr<Action> > Actions;
+  /** the same actions sorted by handle id */
+  typedef std::vector<std::pair<int, const Action*> > ActionTable;
 
   void parse_action(const ReaderMapping& lispreader, const std::string& basedir);
   /** Get an action */
   const Action* get_action(const std::string& act) const;
+  const Action* get_action(const SpriteAction& act) const;
 
   Actions actions;
+  ActionTable action_table;
   std::string name;
 };
 
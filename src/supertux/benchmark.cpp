@@ -0,0 +1,124 @@
+//  SuperTux
+//  Copyright (C) 2018 SuperTux Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "supertux/benchmark.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <string>
+
+#ifndef WIN32
+#  include <sys/resource.h>
+#endif
+
+#include "badguy/badguy.hpp"
+#include "supertux/sector.hpp"
+#include "util/profiler.hpp"
+
+namespace {
+
+/** Returns the peak resident set size of the process in KiB, or -1 if
+    it can't be determined on this platform */
+long get_peak_memory()
+{
+#ifdef WIN32
+  return -1;
+#else
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return -1;
+
+#ifdef __APPLE__
+  // reported in bytes instead of KiB
+  return usage.ru_maxrss / 1024;
+#else
+  return usage.ru_maxrss;
+#endif
+#endif
+}
+
+} // namespace
+
+Benchmark::Benchmark() :
+  m_start(std::chrono::steady_clock::now()),
+  m_frames(0),
+  m_last(),
+  m_peak()
+{
+}
+
+void
+Benchmark::update()
+{
+  m_frames += 1;
+
+  auto sector = Sector::current();
+  if (!sector)
+    return;
+
+  m_last.objects = sector->get_total_count<GameObject>();
+  m_last.moving_objects = sector->get_total_count<MovingObject>();
+  m_last.badguys = sector->get_total_count<BadGuy>();
+
+  m_peak.objects = std::max(m_peak.objects, m_last.objects);
+  m_peak.moving_objects = std::max(m_peak.moving_objects, m_last.moving_objects);
+  m_peak.badguys = std::max(m_peak.badguys, m_last.badguys);
+}
+
+void
+Benchmark::print_report(std::ostream& out) const
+{
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+
+  out << std::fixed << std::setprecision(3)
+      << "Benchmark: " << m_frames << " frames in " << seconds << " s";
+  if (seconds > 0.0)
+    out << " (" << std::setprecision(1) << m_frames / seconds << " fps)";
+  out << "\n\n";
+
+  auto profiler = Profiler::current();
+  if (profiler)
+  {
+    out << std::left << std::setw(32) << "phase"
+        << std::right << std::setw(12) << "avg ms" << std::setw(12) << "peak ms" << "\n";
+    out << std::setprecision(3);
+    for(const auto& entry : profiler->get_totals())
+    {
+      out << std::left << std::setw(32) << (std::string(entry.depth * 2, ' ') + entry.name)
+          << std::right << std::setw(12) << entry.average << std::setw(12) << entry.peak << "\n";
+    }
+    out << "\n";
+  }
+
+  long peak_memory = get_peak_memory();
+  if (peak_memory < 0)
+    out << "peak memory: unknown\n";
+  else
+    out << "peak memory: " << peak_memory << " KiB\n";
+
+  out << std::left << std::setw(32) << "objects"
+      << std::right << std::setw(12) << "last" << std::setw(12) << "peak" << "\n"
+      << std::left << std::setw(32) << "  GameObject"
+      << std::right << std::setw(12) << m_last.objects << std::setw(12) << m_peak.objects << "\n"
+      << std::left << std::setw(32) << "  MovingObject"
+      << std::right << std::setw(12) << m_last.moving_objects << std::setw(12) << m_peak.moving_objects << "\n"
+      << std::left << std::setw(32) << "  BadGuy"
+      << std::right << std::setw(12) << m_last.badguys << std::setw(12) << m_peak.badguys << "\n"
+      << std::flush;
+}
+
+/* EOF */
@@ -0,0 +1,63 @@
+//  SuperTux
+//  Copyright (C) 2018 SuperTux Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef HEADER_SUPERTUX_SUPERTUX_BENCHMARK_HPP
+#define HEADER_SUPERTUX_SUPERTUX_BENCHMARK_HPP
+
+#include <chrono>
+#include <ostream>
+
+/**
+ * Collects the statistics of a --benchmark run that the Profiler
+ * doesn't know about: wall time, object counts and memory use.
+ */
+class Benchmark final
+{
+public:
+  Benchmark();
+
+  /** Samples the object counts of the current Sector, call once per frame */
+  void update();
+
+  /** Prints the per-phase timings of the current Profiler along with
+      the collected statistics */
+  void print_report(std::ostream& out) const;
+
+private:
+  struct ObjectCounts
+  {
+    ObjectCounts() : objects(0), moving_objects(0), badguys(0) {}
+
+    int objects;
+    int moving_objects;
+    int badguys;
+  };
+
+private:
+  std::chrono::steady_clock::time_point m_start;
+  int m_frames;
+  ObjectCounts m_last;
+  ObjectCounts m_peak;
+
+private:
+  Benchmark(const Benchmark&) = delete;
+  Benchmark& operator=(const Benchmark&) = delete;
+};
+
+#endif
+
+/* EOF */
@@ -0,0 +1,191 @@
+//  SuperTux
+//  Copyright (C) 2018 SuperTux Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "supertux/collision_grid.hpp"
+
+#include <algorithm>
+#include <math.h>
+
+#include "supertux/collision.hpp"
+
+namespace {
+
+// rectangles covering more cells than this in either direction are kept
+// in a separate list instead of being spread over the grid
+const int MAX_CELL_SPAN = 32;
+
+} // namespace
+
+CollisionGrid::CollisionGrid(float cell_size) :
+  m_cell_size(cell_size),
+  m_cells(),
+  m_oversized(),
+  m_size(0)
+{
+}
+
+void
+CollisionGrid::clear()
+{
+  // drop the cells completely when the set of used cells changed a lot,
+  // otherwise only empty them so their storage can be reused next frame
+  if(m_cells.size() > static_cast<size_t>(4 * m_size + 64)) {
+    m_cells.clear();
+  } else {
+    for(auto& cell : m_cells) {
+      cell.second.clear();
+    }
+  }
+  m_oversized.clear();
+  m_size = 0;
+}
+
+uint64_t
+CollisionGrid::get_key(int x, int y)
+{
+  return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+}
+
+bool
+CollisionGrid::get_cell_range(const Rectf& rect, int& x1, int& y1, int& x2, int& y2) const
+{
+  float fx1 = floorf(rect.p1.x / m_cell_size);
+  float fy1 = floorf(rect.p1.y / m_cell_size);
+  float fx2 = floorf(rect.p2.x / m_cell_size);
+  float fy2 = floorf(rect.p2.y / m_cell_size);
+
+  // also catches NaN and infinite coordinates
+  if(!(fx2 - fx1 <= MAX_CELL_SPAN) || !(fy2 - fy1 <= MAX_CELL_SPAN))
+    return false;
+  if(!(fabsf(fx1) < 1e9f) || !(fabsf(fy1) < 1e9f) ||
+     !(fabsf(fx2) < 1e9f) || !(fabsf(fy2) < 1e9f))
+    return false;
+
+  x1 = static_cast<int>(fx1);
+  y1 = static_cast<int>(fy1);
+  x2 = static_cast<int>(fx2);
+  y2 = static_cast<int>(fy2);
+  return true;
+}
+
+void
+CollisionGrid::insert(int index, const Rectf& rect)
+{
+  m_size += 1;
+  add(index, rect);
+}
+
+void
+CollisionGrid::move(int index, const Rectf& old_rect, const Rectf& new_rect)
+{
+  remove(index, old_rect);
+  add(index, new_rect);
+}
+
+bool
+CollisionGrid::update(int index, const Rectf& old_rect, const Rectf& new_rect)
+{
+  if(old_rect.p1 == new_rect.p1 && old_rect.p2 == new_rect.p2)
+    return false;
+
+  move(index, old_rect, new_rect);
+  return true;
+}
+
+void
+CollisionGrid::add(int index, const Rectf& rect)
+{
+  int x1, y1, x2, y2;
+  if(!get_cell_range(rect, x1, y1, x2, y2)) {
+    m_oversized.push_back({index, rect});
+    return;
+  }
+
+  for(int y = y1; y <= y2; ++y) {
+    for(int x = x1; x <= x2; ++x) {
+      m_cells[get_key(x, y)].push_back({index, rect});
+    }
+  }
+}
+
+void
+CollisionGrid::remove(int index, const Rectf& rect)
+{
+  auto erase_entry = [index](std::vector<Entry>& entries) {
+    auto it = std::find_if(entries.begin(), entries.end(),
+                           [index](const Entry& entry) { return entry.index == index; });
+    if(it != entries.end()) {
+      // the order inside a cell doesn't matter, query() sorts its result
+      *it = entries.back();
+      entries.pop_back();
+    }
+  };
+
+  int x1, y1, x2, y2;
+  if(!get_cell_range(rect, x1, y1, x2, y2)) {
+    erase_entry(m_oversized);
+    return;
+  }
+
+  for(int y = y1; y <= y2; ++y) {
+    for(int x = x1; x <= x2; ++x) {
+      auto it = m_cells.find(get_key(x, y));
+      if(it != m_cells.end())
+        erase_entry(it->second);
+    }
+  }
+}
+
+void
+CollisionGrid::query(const Rectf& rect, std::vector<int>& result) const
+{
+  result.clear();
+
+  for(const auto& entry : m_oversized) {
+    if(collision::intersects(rect, entry.rect))
+      result.push_back(entry.index);
+  }
+
+  int x1, y1, x2, y2;
+  if(!get_cell_range(rect, x1, y1, x2, y2)) {
+    // the query itself is huge, walking the used cells is cheaper
+    for(const auto& cell : m_cells) {
+      for(const auto& entry : cell.second) {
+        if(collision::intersects(rect, entry.rect))
+          result.push_back(entry.index);
+      }
+    }
+  } else {
+    for(int y = y1; y <= y2; ++y) {
+      for(int x = x1; x <= x2; ++x) {
+        auto it = m_cells.find(get_key(x, y));
+        if(it == m_cells.end())
+          continue;
+
+        for(const auto& entry : it->second) {
+          if(collision::intersects(rect, entry.rect))
+            result.push_back(entry.index);
+        }
+      }
+    }
+  }
+
+  // entries spanning several cells are reported once per cell
+  std::sort(result.begin(), result.end());
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+}
+
+/* EOF */
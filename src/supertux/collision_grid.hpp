@@ -0,0 +1,117 @@
+//  SuperTux
+//  Copyright (C) 2018 SuperTux Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_SUPERTUX_COLLISION_GRID_HPP
+#define HEADER_SUPERTUX_SUPERTUX_COLLISION_GRID_HPP
+
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+
+#include "math/rectf.hpp"
+
+/**
+ * Uniform grid used as collision broadphase. Rectangles are inserted
+ * with a caller supplied index, queries return the indices of all
+ * inserted rectangles that intersect the query rectangle, sorted in
+ * ascending order so callers can keep a deterministic pair order.
+ */
+class CollisionGrid final
+{
+public:
+  CollisionGrid(float cell_size = 64.0f);
+
+  /** Removes all entries, keeps the allocated cells for reuse */
+  void clear();
+
+  void insert(int index, const Rectf& rect);
+
+  /** Moves the entry index, which was inserted or last moved with
+      old_rect, to new_rect */
+  void move(int index, const Rectf& old_rect, const Rectf& new_rect);
+
+  /** Fills result with the sorted indices of all entries intersecting rect */
+  void query(const Rectf& rect, std::vector<int>& result) const;
+
+  /** Calls func(other) for every entry other > index that intersects
+      the entry index, in ascending order. get_rect(i) returns the
+      current rect of entry i, func may move the rects of index and
+      other. The grid follows such moves, so entries that only overlap
+      after a push are still visited, just like a loop over all entries
+      would do. candidates is used as scratch space. */
+  template<class GetRect, class Func>
+  void query_following(int index, const GetRect& get_rect, const Func& func,
+                       std::vector<int>& candidates)
+  {
+    int next = index + 1;
+    bool moved;
+    do {
+      moved = false;
+      Rectf rect = get_rect(index);
+      query(rect, candidates);
+      for(const auto& other : candidates) {
+        if(other < next)
+          continue;
+        next = other + 1;
+
+        Rectf other_rect = get_rect(other);
+        func(other);
+        update(other, other_rect, get_rect(other));
+        if(update(index, rect, get_rect(index))) {
+          // the candidates were collected for the old rect
+          moved = true;
+          break;
+        }
+      }
+    } while(moved);
+  }
+
+private:
+  struct Entry
+  {
+    int index;
+    Rectf rect;
+  };
+
+  typedef std::vector<Entry> Cell;
+
+  void add(int index, const Rectf& rect);
+  void remove(int index, const Rectf& rect);
+
+  /** Moves the entry if new_rect differs from old_rect, returns true if it did */
+  bool update(int index, const Rectf& old_rect, const Rectf& new_rect);
+
+  bool get_cell_range(const Rectf& rect, int& x1, int& y1, int& x2, int& y2) const;
+  static uint64_t get_key(int x, int y);
+
+private:
+  float m_cell_size;
+  std::unordered_map<uint64_t, Cell> m_cells;
+
+  /** entries spanning too many cells, tested against every query */
+  std::vector<Entry> m_oversized;
+
+  /** number of entries inserted since the last clear() */
+  int m_size;
+
+private:
+  CollisionGrid(const CollisionGrid&) = delete;
+  CollisionGrid& operator=(const CollisionGrid&) = delete;
+};
+
+#endif
+
+/* EOF */
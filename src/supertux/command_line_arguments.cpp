@@ -29,6 +29,8 @@ CommandLineArguments::CommandLineArguments() :
   m_log_level(LOG_WARNING),
   datadir(),
   userdir(),
+  convert_input(),
+  convert_output(),
   fullscreen_size(),
   fullscreen_refresh_rate(),
   window_size(),
@@ -37,12 +39,15 @@ CommandLineArguments::CommandLineArguments() :
   video(),
   show_fps(),
   show_player_pos(),
+  show_profiler(),
+  profile_trace(),
   sound_enabled(),
   music_enabled(),
   start_level(),
   enable_script_debugger(),
   start_demo(),
   record_demo(),
+  benchmark(),
   tux_spawn_pos(),
   developer_mode(),
   christmas_mode(),
@@ -74,14 +79,15 @@ CommandLineArguments::print_help(const char* arg0) const
             << _(     "  -v, --version                Show SuperTux version and quit") << "\n"
             << _(     "  --verbose                    Print verbose messages") << "\n"
             << _(     "  --debug                      Print extra verbose messages") << "\n"
-            << _( "  --print-datadir              Print SuperTux's primary data directory.") << "\n" << "\n"
+            << _( "  --print-datadir              Print SuperTux's primary data directory.") << "\n"
+            << _(     "  --convert-level IN OUT       Convert a level from text to binary format or back") << "\n" << "\n"
             << _(     "Video Options:") << "\n"
             << _(     "  -f, --fullscreen             Run in fullscreen mode") << "\n"
             << _(     "  -w, --window                 Run in window mode") << "\n"
             << _(     "  -g, --geometry WIDTHxHEIGHT  Run SuperTux in given resolution") << "\n"
             << _(     "  -a, --aspect WIDTH:HEIGHT    Run SuperTux with given aspect ratio") << "\n"
             << _(     "  -d, --default                Reset video settings to default values") << "\n"
-            << _(     "  --renderer RENDERER          Use sdl, opengl, or auto to render") << "\n" << "\n"
+            << _(     "  --renderer RENDERER          Use sdl, opengl, opengl-vbo, null, or auto to render") << "\n" << "\n"
             << _(     "Audio Options:") << "\n"
             << _(     "  --disable-sound              Disable sound effects") << "\n"
             << _(     "  --disable-music              Disable music") << "\n" << "\n"
@@ -91,12 +97,15 @@ CommandLineArguments::print_help(const char* arg0) const
             << _(     "  --no-show-fps                Do not display framerate in levels") << "\n"
             << _(     "  --show-pos                   Display player's current position") << "\n"
             << _(     "  --no-show-pos                Do not display player's position") << "\n"
+            << _(     "  --show-profiler              Display the time spent in each part of a frame") << "\n"
+            << _(     "  --profile-trace FILE         Write frame timings to FILE in Chrome trace format") << "\n"
             << _(     "  --developer                  Switch on developer feature") << "\n"
             << _(     "  -s, --debug-scripts          Enable script debugger.") << "\n"
             << _(     "  --spawn-pos X,Y              Where in the level to spawn Tux. Only used if level is specified.") << "\n" << "\n"
             << _(     "Demo Recording Options:") << "\n"
             << _(     "  --record-demo FILE LEVEL     Record a demo to FILE") << "\n"
-            << _(     "  --play-demo FILE LEVEL       Play a recorded demo") << "\n" << "\n"
+            << _(     "  --play-demo FILE LEVEL       Play a recorded demo") << "\n"
+            << _(     "  --benchmark LEVEL DEMO       Play a demo headless and as fast as possible, then print timings") << "\n" << "\n"
             << _(     "Directory Options:") << "\n"
             << _(     "  --datadir DIR                Set the directory for the games datafiles") << "\n"
             << _(     "  --userdir DIR                Set the directory for user data (savegames, etc.)") << "\n" << "\n"
@@ -137,6 +146,19 @@ CommandLineArguments::parse_args(int argc, char** argv)
     {
       m_action = PRINT_DATADIR;
     }
+    else if (arg == "--convert-level")
+    {
+      if (i + 2 >= argc)
+      {
+        throw std::runtime_error("Need to specify an input and an output file for --convert-level");
+      }
+      else
+      {
+        m_action = CONVERT_LEVEL;
+        convert_input = argv[++i];
+        convert_output = argv[++i];
+      }
+    }
     else if (arg == "--debug")
     {
       m_log_level = LOG_DEBUG;
@@ -272,6 +294,21 @@ CommandLineArguments::parse_args(int argc, char** argv)
     {
       show_player_pos = false;
     }
+    else if (arg == "--show-profiler")
+    {
+      show_profiler = true;
+    }
+    else if (arg == "--profile-trace")
+    {
+      if (i + 1 >= argc)
+      {
+        throw std::runtime_error("Need to specify a file for --profile-trace");
+      }
+      else
+      {
+        profile_trace = argv[++i];
+      }
+    }
     else if (arg == "--developer")
     {
       developer_mode = true;
@@ -314,6 +351,22 @@ CommandLineArguments::parse_args(int argc, char** argv)
         record_demo = argv[++i];
       }
     }
+    else if (arg == "--benchmark")
+    {
+      if (i + 2 >= argc)
+      {
+        throw std::runtime_error("Need to specify a level and a demo file for --benchmark");
+      }
+      else
+      {
+        start_level = argv[++i];
+        start_demo = argv[++i];
+        benchmark = true;
+        video = VideoSystem::NULL_VIDEO;
+        sound_enabled = false;
+        music_enabled = false;
+      }
+    }
     else if (arg == "--spawn-pos")
     {
       Vector spawn_pos;
@@ -384,12 +437,15 @@ CommandLineArguments::merge_into(Config& config)
   merge_option(video);
   merge_option(show_fps);
   merge_option(show_player_pos);
+  merge_option(show_profiler);
+  merge_option(profile_trace);
   merge_option(sound_enabled);
   merge_option(music_enabled);
   merge_option(start_level);
   merge_option(enable_script_debugger);
   merge_option(start_demo);
   merge_option(record_demo);
+  merge_option(benchmark);
   merge_option(tux_spawn_pos);
   merge_option(developer_mode);
   merge_option(christmas_mode);
@@ -35,7 +35,8 @@ public:
     NO_ACTION,
     PRINT_VERSION,
     PRINT_HELP,
-    PRINT_DATADIR
+    PRINT_DATADIR,
+    CONVERT_LEVEL
   };
 
 private:
@@ -46,6 +47,9 @@ public:
   boost::optional<std::string> datadir;
   boost::optional<std::string> userdir;
 
+  boost::optional<std::string> convert_input;
+  boost::optional<std::string> convert_output;
+
   boost::optional<Size> fullscreen_size;
   boost::optional<int> fullscreen_refresh_rate;
   boost::optional<Size> window_size;
@@ -59,6 +63,8 @@ public:
   // boost::optional<bool> try_vsync;
   boost::optional<bool> show_fps;
   boost::optional<bool> show_player_pos;
+  boost::optional<bool> show_profiler;
+  boost::optional<std::string> profile_trace;
   boost::optional<bool> sound_enabled;
   boost::optional<bool> music_enabled;
 
@@ -68,6 +74,7 @@ public:
   boost::optional<bool> enable_script_debugger;
   boost::optional<std::string> start_demo;
   boost::optional<std::string> record_demo;
+  boost::optional<bool> benchmark;
   boost::optional<Vector> tux_spawn_pos;
 
   boost::optional<bool> developer_mode;
@@ -16,7 +16,9 @@
 
 #include "supertux/game_manager.hpp"
 
+#include "supertux/level_metadata_cache.hpp"
 #include "supertux/levelset_screen.hpp"
+#include "supertux/loading_screen.hpp"
 #include "supertux/player_status.hpp"
 #include "supertux/savegame.hpp"
 #include "supertux/screen.hpp"
@@ -73,8 +75,12 @@ GameManager::run_worldmap(World* world, const std::string& worldmap_filename, co
       filename = world->get_worldmap_filename();
     }
 
-    auto worldmap = new worldmap::WorldMap(filename, *m_savegame, spawnpoint);
-    ScreenManager::current()->push_screen(std::unique_ptr<Screen>(worldmap));
+    Savegame& savegame = *m_savegame;
+    ScreenManager::current()->push_screen(std::unique_ptr<Screen>(new LoadingScreen(
+      filename,
+      [filename, &savegame, spawnpoint](const ReaderDocument* doc) {
+        return std::unique_ptr<Screen>(new worldmap::WorldMap(filename, savegame, spawnpoint, doc));
+      })));
   }
   catch(std::exception& e)
   {
@@ -113,6 +119,9 @@ GameManager::get_level_name(const std::string& filename) const
 {
   try
   {
+    if (LevelMetadataCache::current())
+      return LevelMetadataCache::current()->get(filename).title;
+
     register_translation_directory(filename);
     auto doc = ReaderDocument::parse(filename);
     auto root = doc.get_root();
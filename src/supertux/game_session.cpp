@@ -27,6 +27,7 @@
 #include "supertux/fadein.hpp"
 #include "supertux/gameconfig.hpp"
 #include "supertux/level.hpp"
+#include "supertux/level_metadata_cache.hpp"
 #include "supertux/level_parser.hpp"
 #include "supertux/levelintro.hpp"
 #include "supertux/levelset_screen.hpp"
@@ -40,7 +41,8 @@
 #include "video/surface.hpp"
 #include "worldmap/worldmap.hpp"
 
-GameSession::GameSession(const std::string& levelfile_, Savegame& savegame, Statistics* statistics) :
+GameSession::GameSession(const std::string& levelfile_, Savegame& savegame, Statistics* statistics,
+                         const ReaderDocument* doc) :
   GameSessionRecorder(),
   reset_button(false),
   level(),
@@ -68,10 +70,13 @@ GameSession::GameSession(const std::string& levelfile_, Savegame& savegame, Stat
   max_fire_bullets_at_start(),
   max_ice_bullets_at_start(),
   active(false),
-  end_seq_started(false)
+  end_seq_started(false),
+  m_level_doc(doc)
 {
   if (restart_level() != 0)
     throw std::runtime_error ("Initializing the level failed.");
+
+  m_level_doc = nullptr;
 }
 
 void
@@ -114,12 +119,22 @@ GameSession::restart_level(bool after_death)
 
   try {
     old_level = std::move(level);
-    level = LevelParser::from_file(levelfile);
+    if (m_level_doc) {
+      level = LevelParser::from_document(levelfile, *m_level_doc);
+    } else {
+      level = LevelParser::from_file(levelfile);
+    }
     level->stats.total_coins = level->get_total_coins();
     level->stats.total_badguys = level->get_total_badguys();
     level->stats.total_secrets = level->get_total_secrets();
     level->stats.reset();
 
+    // keep the sounds of this level cached
+    SoundManager::current()->set_manifest(level->sounds);
+
+    if (LevelMetadataCache::current())
+      LevelMetadataCache::current()->update(levelfile, *level);
+
     if(!reset_sector.empty()) {
       currentsector = level->get_sector(reset_sector);
       if(!currentsector) {
@@ -284,7 +299,7 @@ GameSession::setup()
   currentsector->play_music(LEVEL_MUSIC);
 
   int total_stats_to_be_collected = level->stats.total_coins + level->stats.total_badguys + level->stats.total_secrets;
-  if ((!levelintro_shown) && (total_stats_to_be_collected > 0)) {
+  if ((!levelintro_shown) && (total_stats_to_be_collected > 0) && !g_config->benchmark) {
     levelintro_shown = true;
     active = false;
     ScreenManager::current()->push_screen(std::unique_ptr<Screen>(new LevelIntro(level.get(), best_level_statistics, m_savegame.get_player_status())));
@@ -325,6 +340,10 @@ GameSession::update(float elapsed_time)
 
   process_events();
 
+  if (g_config->benchmark && is_demo_finished()) {
+    ScreenManager::current()->quit();
+  }
+
   // Unpause the game if the menu has been closed
   if (game_pause && !MenuManager::instance().is_active()) {
     ScreenManager::current()->set_speed(speed_before_pause);
@@ -520,11 +539,9 @@ GameSession::start_sequence(Sequence seq, const SequenceData* data)
   currentsector->player->set_winning();
 
   // Stop all clocks.
-  for(const auto& obj : currentsector->gameobjects)
+  for(const auto& lt : currentsector->get_objects_by_type<LevelTime>())
   {
-    auto lt = std::dynamic_pointer_cast<LevelTime>(obj);
-    if(lt)
-      lt->stop();
+    lt->stop();
   }
 }
 
@@ -33,6 +33,7 @@ class CodeController;
 class DrawingContext;
 class EndSequence;
 class Level;
+class ReaderDocument;
 class Sector;
 class Statistics;
 class Savegame;
@@ -45,7 +46,9 @@ class GameSession : public Screen,
                     public Currenton<GameSession>
 {
 public:
-  GameSession(const std::string& levelfile, Savegame& savegame, Statistics* statistics = NULL);
+  /** doc is the already parsed levelfile, if available */
+  GameSession(const std::string& levelfile, Savegame& savegame, Statistics* statistics = NULL,
+              const ReaderDocument* doc = nullptr);
 
   virtual void draw(Compositor& compositor) override;
   virtual void update(float frame_ratio) override;
@@ -153,6 +156,9 @@ private:
 
   bool end_seq_started;
 
+  /** parsed levelfile passed to the constructor, only used for the first load */
+  const ReaderDocument* m_level_doc;
+
 private:
   GameSession(const GameSession&) = delete;
   GameSession& operator=(const GameSession&) = delete;
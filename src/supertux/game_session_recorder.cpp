@@ -123,6 +123,12 @@ GameSessionRecorder::play_demo(const std::string& filename)
   m_playing = false;
 }
 
+bool
+GameSessionRecorder::is_demo_finished() const
+{
+  return playback_demo_stream != 0 && playback_demo_stream->eof();
+}
+
 void
 GameSessionRecorder::reset_demo_controller()
 {
@@ -43,6 +43,9 @@ public:
     return m_playing;
   }
 
+  /** True once all input of the demo passed to play_demo() was used up */
+  bool is_demo_finished() const;
+
 private:
   void capture_demo_step();
 
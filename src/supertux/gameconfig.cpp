@@ -32,8 +32,11 @@ Config::Config() :
   use_fullscreen(false),
   video(VideoSystem::AUTO_VIDEO),
   try_vsync(true),
+  use_texture_atlas(true),
   show_fps(false),
   show_player_pos(false),
+  show_profiler(false),
+  profile_trace(),
   sound_enabled(true),
   music_enabled(true),
   random_seed(0), // set by time(), by default (unless in config)
@@ -41,6 +44,7 @@ Config::Config() :
   enable_script_debugger(false),
   start_demo(),
   record_demo(),
+  benchmark(false),
   tux_spawn_pos(),
   edit_level(),
   locale(),
@@ -93,6 +97,7 @@ Config::load()
     config_video_lisp.get("video", video_string);
     video = VideoSystem::get_video_system(video_string);
     config_video_lisp.get("vsync", try_vsync);
+    config_video_lisp.get("texture_atlas", use_texture_atlas);
 
     config_video_lisp.get("fullscreen_width",  fullscreen_size.width);
     config_video_lisp.get("fullscreen_height", fullscreen_size.height);
@@ -184,6 +189,7 @@ Config::save()
   writer.write("fullscreen", use_fullscreen);
   writer.write("video", VideoSystem::get_video_string(video));
   writer.write("vsync", try_vsync);
+  writer.write("texture_atlas", use_texture_atlas);
 
   writer.write("fullscreen_width",  fullscreen_size.width);
   writer.write("fullscreen_height", fullscreen_size.height);
@@ -54,8 +54,20 @@ public:
   bool use_fullscreen;
   VideoSystem::Enum video;
   bool try_vsync;
+
+  /** pack small images into shared textures, so that consecutive
+      draws of them can be merged */
+  bool use_texture_atlas;
   bool show_fps;
   bool show_player_pos;
+
+  /** show the frame profiler overlay */
+  bool show_profiler;
+
+  /** if set, profiler scopes get written to this file in the Chrome
+      trace event format */
+  std::string profile_trace;
+
   bool sound_enabled;
   bool music_enabled;
 
@@ -68,6 +80,10 @@ public:
   std::string start_demo;
   std::string record_demo;
 
+  /** play start_demo without display and frame pacing and print
+      timings at the end, not saved */
+  bool benchmark;
+
   /** this variable is set if tux should spawn somewhere which isn't the "main" spawn point*/
   boost::optional<Vector> tux_spawn_pos;
 
@@ -38,7 +38,8 @@ Level::Level() :
   sectors(),
   stats(),
   target_time(),
-  tileset("images/tiles.strf")
+  tileset("images/tiles.strf"),
+  sounds()
 {
   _current = this;
 }
@@ -162,31 +163,19 @@ Level::get_total_coins() const
 {
   int total_coins = 0;
   for(auto const& sector : sectors) {
-    for(const auto& o: sector->gameobjects) {
-      auto coin = dynamic_cast<Coin*>(o.get());
-      if(coin)
+    total_coins += sector->get_total_count<Coin>();
+    for(const auto& block : sector->get_objects_by_type<BonusBlock>())
+    {
+      if (block->contents == BonusBlock::CONTENT_COIN)
       {
-        total_coins++;
-        continue;
-      }
-      auto block = dynamic_cast<BonusBlock*>(o.get());
-      if(block)
+        total_coins += block->hit_counter;
+      } else if (block->contents == BonusBlock::CONTENT_RAIN ||
+                 block->contents == BonusBlock::CONTENT_EXPLODE)
       {
-        if (block->contents == BonusBlock::CONTENT_COIN)
-        {
-          total_coins += block->hit_counter;
-          continue;
-        } else if (block->contents == BonusBlock::CONTENT_RAIN ||
-                   block->contents == BonusBlock::CONTENT_EXPLODE)
-        {
-          total_coins += 10;
-          continue;
-        }
-      }
-      auto goldbomb = dynamic_cast<GoldBomb*>(o.get());
-      if(goldbomb)
         total_coins += 10;
+      }
     }
+    total_coins += 10 * sector->get_total_count<GoldBomb>();
   }
   return total_coins;
 }
@@ -40,6 +40,10 @@ public:
   float       target_time;
   std::string tileset;
 
+  /** sounds preloaded while the sectors were parsed, the preload
+      manifest of the level */
+  std::vector<std::string> sounds;
+
   friend class LevelParser;
 
 public:
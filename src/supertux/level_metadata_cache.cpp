@@ -0,0 +1,198 @@
+//  SuperTux
+//  Copyright (C) 2018 SuperTux Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "supertux/level_metadata_cache.hpp"
+
+#include <physfs.h>
+
+#include "physfs/physfs_file_system.hpp"
+#include "supertux/level.hpp"
+#include "util/gettext.hpp"
+#include "util/log.hpp"
+#include "util/reader.hpp"
+#include "util/reader_document.hpp"
+#include "util/reader_iterator.hpp"
+#include "util/reader_mapping.hpp"
+#include "util/writer.hpp"
+
+LevelMetadataCache::LevelMetadataCache(const std::string& filename) :
+  m_filename(filename),
+  m_entries(),
+  m_dirty(false)
+{
+  load();
+}
+
+LevelMetadataCache::~LevelMetadataCache()
+{
+  save();
+}
+
+LevelMetadata
+LevelMetadataCache::get(const std::string& filename)
+{
+  Entry entry;
+  bool cacheable = get_file_key(filename, entry);
+  if (cacheable)
+  {
+    auto it = m_entries.find(filename);
+    if (it != m_entries.end() &&
+        it->second.mtime == entry.mtime &&
+        it->second.size == entry.size &&
+        it->second.language == entry.language)
+    {
+      return it->second.metadata;
+    }
+  }
+
+  register_translation_directory(filename);
+  auto doc = ReaderDocument::parse(filename);
+  auto root = doc.get_root();
+  if (root.get_name() == "supertux-level")
+  {
+    auto mapping = root.get_mapping();
+    mapping.get("name", entry.metadata.title);
+    mapping.get("target-time", entry.metadata.target_time);
+  }
+
+  if (cacheable)
+  {
+    m_entries[filename] = entry;
+    m_dirty = true;
+  }
+
+  return entry.metadata;
+}
+
+void
+LevelMetadataCache::update(const std::string& filename, const Level& level)
+{
+  // the editor loads levels with untranslated titles
+  if (!ReaderMapping::translations_enabled)
+    return;
+
+  Entry entry;
+  if (!get_file_key(filename, entry))
+    return;
+
+  entry.metadata.title = level.name;
+  entry.metadata.target_time = level.target_time;
+
+  m_entries[filename] = entry;
+  m_dirty = true;
+}
+
+bool
+LevelMetadataCache::get_file_key(const std::string& filename, Entry& entry) const
+{
+  PHYSFS_Stat statbuf;
+  if (!PHYSFS_stat(filename.c_str(), &statbuf) ||
+      statbuf.filetype != PHYSFS_FILETYPE_REGULAR)
+  {
+    return false;
+  }
+
+  // only compared for equality, so truncating to what the reader
+  // supports is fine
+  entry.mtime = static_cast<int>(statbuf.modtime);
+  entry.size = static_cast<int>(statbuf.filesize);
+  entry.language = g_dictionary_manager ?
+    g_dictionary_manager->get_language().get_language() : std::string();
+  return true;
+}
+
+void
+LevelMetadataCache::load()
+{
+  if (!PHYSFS_exists(m_filename.c_str()) || PhysFSFileSystem::is_directory(m_filename))
+    return;
+
+  try
+  {
+    auto doc = ReaderDocument::parse(m_filename);
+    auto root = doc.get_root();
+    if (root.get_name() != "supertux-level-cache")
+      throw std::runtime_error("file is not a supertux-level-cache file");
+
+    auto mapping = root.get_mapping();
+    int version = 1;
+    mapping.get("version", version);
+    if (version != 1)
+      throw std::runtime_error("incompatible level cache version");
+
+    auto iter = mapping.get_iter();
+    while (iter.next())
+    {
+      if (iter.get_key() != "level")
+        continue;
+
+      auto level = iter.as_mapping();
+      std::string filename;
+      Entry entry;
+      if (!level.get("file", filename) ||
+          !level.get("mtime", entry.mtime) ||
+          !level.get("size", entry.size))
+        continue;
+
+      level.get("language", entry.language);
+      level.get("title", entry.metadata.title);
+      level.get("target-time", entry.metadata.target_time);
+      m_entries[filename] = entry;
+    }
+  }
+  catch(const std::exception& e)
+  {
+    log_warning << "Couldn't load level cache '" << m_filename << "': " << e.what() << std::endl;
+    m_entries.clear();
+  }
+}
+
+void
+LevelMetadataCache::save()
+{
+  if (!m_dirty)
+    return;
+
+  try
+  {
+    Writer writer(m_filename);
+
+    writer.start_list("supertux-level-cache");
+    writer.write("version", 1);
+    for (const auto& it : m_entries)
+    {
+      const Entry& entry = it.second;
+      writer.start_list("level");
+      writer.write("file", it.first);
+      writer.write("mtime", entry.mtime);
+      writer.write("size", entry.size);
+      writer.write("language", entry.language);
+      writer.write("title", entry.metadata.title);
+      writer.write("target-time", entry.metadata.target_time);
+      writer.end_list("level");
+    }
+    writer.end_list("supertux-level-cache");
+
+    m_dirty = false;
+  }
+  catch(const std::exception& e)
+  {
+    log_warning << "Couldn't save level cache '" << m_filename << "': " << e.what() << std::endl;
+  }
+}
+
+/* EOF */
@@ -0,0 +1,88 @@
+//  SuperTux
+//  Copyright (C) 2018 SuperTux Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef HEADER_SUPERTUX_SUPERTUX_LEVEL_METADATA_CACHE_HPP
+#define HEADER_SUPERTUX_SUPERTUX_LEVEL_METADATA_CACHE_HPP
+
+#include <string>
+#include <unordered_map>
+
+#include "util/currenton.hpp"
+
+class Level;
+
+struct LevelMetadata
+{
+public:
+  LevelMetadata() :
+    title(),
+    target_time(0.0f)
+  {}
+
+  std::string title;
+  float target_time;
+};
+
+/**
+ * Persistent cache of the title and target time of level files, so
+ * that worldmaps and level menus don't have to parse every level they
+ * list. Entries are keyed by the PhysFS filename and are
+ * invalidated when the modification time or size of the file or the
+ * active language changes.
+ */
+class LevelMetadataCache final : public Currenton<LevelMetadataCache>
+{
+public:
+  LevelMetadataCache(const std::string& filename = "levelcache");
+  ~LevelMetadataCache();
+
+  /** Returns the metadata of the given level file, parsing it if
+      there is no current entry, throws if the file can't be read */
+  LevelMetadata get(const std::string& filename);
+
+  /** Stores the metadata of a level that was just loaded */
+  void update(const std::string& filename, const Level& level);
+
+  void save();
+
+private:
+  struct Entry
+  {
+    Entry() : mtime(0), size(0), language(), metadata() {}
+
+    int mtime;
+    int size;
+    std::string language;
+    LevelMetadata metadata;
+  };
+
+  void load();
+  bool get_file_key(const std::string& filename, Entry& entry) const;
+
+private:
+  std::string m_filename;
+  std::unordered_map<std::string, Entry> m_entries;
+  bool m_dirty;
+
+private:
+  LevelMetadataCache(const LevelMetadataCache&) = delete;
+  LevelMetadataCache& operator=(const LevelMetadataCache&) = delete;
+};
+
+#endif
+
+/* EOF */
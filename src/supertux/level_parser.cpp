@@ -19,6 +19,7 @@
 #include <physfs.h>
 #include <sstream>
 
+#include "audio/sound_manager.hpp"
 #include "supertux/level.hpp"
 #include "supertux/sector.hpp"
 #include "supertux/sector_parser.hpp"
@@ -32,7 +33,16 @@ LevelParser::from_file(const std::string& filename)
 {
   std::unique_ptr<Level> level(new Level);
   LevelParser parser(*level);
-  parser.load(filename);
+  parser.load(filename, nullptr);
+  return level;
+}
+
+std::unique_ptr<Level>
+LevelParser::from_document(const std::string& filename, const ReaderDocument& doc)
+{
+  std::unique_ptr<Level> level(new Level);
+  LevelParser parser(*level);
+  parser.load(filename, &doc);
   return level;
 }
 
@@ -85,13 +95,19 @@ LevelParser::LevelParser(Level& level) :
 }
 
 void
-LevelParser::load(const std::string& filepath)
+LevelParser::load(const std::string& filepath, const ReaderDocument* doc)
 {
+  // collects the sounds preloaded by the objects of the sectors
+  SoundManager::current()->begin_manifest();
   try {
     m_level.filename = filepath;
     register_translation_directory(filepath);
-    auto doc = ReaderDocument::parse(filepath);
-    auto root = doc.get_root();
+    ReaderDocument parsed_doc;
+    if (!doc) {
+      parsed_doc = ReaderDocument::parse_level(filepath);
+      doc = &parsed_doc;
+    }
+    auto root = doc->get_root();
 
     if(root.get_name() != "supertux-level")
       throw std::runtime_error("file is not a supertux-level file.");
@@ -130,10 +146,12 @@ LevelParser::load(const std::string& filepath)
       log_warning << "[" <<  filepath << "] level format version " << version << " is not supported" << std::endl;
     }
   } catch(std::exception& e) {
+    SoundManager::current()->end_manifest();
     std::stringstream msg;
     msg << "Problem when reading level '" << filepath << "': " << e.what();
     throw std::runtime_error(msg.str());
   }
+  m_level.sounds = SoundManager::current()->end_manifest();
 }
 
 void
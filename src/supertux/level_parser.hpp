@@ -21,19 +21,22 @@
 #include <string>
 
 class Level;
+class ReaderDocument;
 class ReaderMapping;
 
 class LevelParser
 {
 public:
   static std::unique_ptr<Level> from_file(const std::string& filename);
+  /** Like from_file(), for a document that was parsed in advance */
+  static std::unique_ptr<Level> from_document(const std::string& filename, const ReaderDocument& doc);
   static std::unique_ptr<Level> from_nothing(const std::string& basedir);
   static std::unique_ptr<Level> from_nothing_worldmap(const std::string& basedir, const std::string& name);
 
 private:
   LevelParser(Level& level);
 
-  void load(const std::string& filepath);
+  void load(const std::string& filepath, const ReaderDocument* doc);
   void load_old_format(const ReaderMapping& reader);
   void create(const std::string& filepath, const std::string& levelname, bool worldmap);
 
@@ -19,6 +19,7 @@
 #include "editor/editor.hpp"
 #include "supertux/game_session.hpp"
 #include "supertux/levelset.hpp"
+#include "supertux/loading_screen.hpp"
 #include "supertux/savegame.hpp"
 #include "supertux/screen_fade.hpp"
 #include "supertux/screen_manager.hpp"
@@ -79,8 +80,13 @@ LevelsetScreen::setup()
       log_warning << "Editor is still active, quiting Levelset screen" << std::endl;
       ScreenManager::current()->pop_screen();
     } else {
-      std::unique_ptr<Screen> screen(new GameSession(FileSystem::join(m_basedir, m_level_filename),
-                                                     m_savegame));
+      std::string filename = FileSystem::join(m_basedir, m_level_filename);
+      Savegame& savegame = m_savegame;
+      std::unique_ptr<Screen> screen(new LoadingScreen(
+        filename,
+        [filename, &savegame](const ReaderDocument* doc) {
+          return std::unique_ptr<Screen>(new GameSession(filename, savegame, NULL, doc));
+        }));
       ScreenManager::current()->push_screen(std::move(screen));
     }
   }
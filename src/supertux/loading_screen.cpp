@@ -0,0 +1,303 @@
+//  SuperTux
+//  Copyright (C) 2018 SuperTux Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "supertux/loading_screen.hpp"
+
+#include <chrono>
+#include <sexp/value.hpp>
+
+#include "audio/sound_manager.hpp"
+#include "physfs/ifile_streambuf.hpp"
+#include "supertux/resources.hpp"
+#include "supertux/screen_fade.hpp"
+#include "supertux/screen_manager.hpp"
+#include "util/file_system.hpp"
+#include "util/gettext.hpp"
+#include "util/log.hpp"
+#include "util/reader_document.hpp"
+#include "util/string_util.hpp"
+#include "video/compositor.hpp"
+#include "video/drawing_context.hpp"
+#include "video/texture_manager.hpp"
+
+namespace {
+
+bool is_image(const std::string& filename)
+{
+  return StringUtil::has_suffix(filename, ".png") ||
+         StringUtil::has_suffix(filename, ".jpg");
+}
+
+bool is_sound(const std::string& filename)
+{
+  return StringUtil::has_suffix(filename, ".wav") ||
+         StringUtil::has_suffix(filename, ".ogg");
+}
+
+template<class F>
+void for_each_string(const sexp::Value& sx, const F& func)
+{
+  if (sx.is_string())
+  {
+    func(sx.as_string());
+  }
+  else if (sx.is_array())
+  {
+    for (const auto& item : sx.as_array())
+    {
+      for_each_string(item, func);
+    }
+  }
+}
+
+template<class T>
+bool is_ready(const std::future<T>& future)
+{
+  return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+} // namespace
+
+struct LoadingScreen::ParseResult
+{
+  ParseResult() : doc(), images(), sounds() {}
+
+  std::unique_ptr<ReaderDocument> doc;
+  std::vector<std::string> images;
+  std::vector<std::string> sounds;
+};
+
+LoadingScreen::LoadingScreen(const std::string& filename, const CreateFunc& create) :
+  m_filename(FileSystem::normalize(filename)),
+  m_create(create),
+  m_parse(),
+  m_decode(),
+  m_doc(),
+  m_images(),
+  m_sounds(),
+  m_done(0),
+  m_total(0),
+  m_finished(false)
+{
+}
+
+LoadingScreen::~LoadingScreen()
+{
+  // the futures wait for their threads, m_images and m_sounds have to
+  // stay valid till then
+  if (m_decode.valid())
+    m_decode.wait();
+}
+
+void
+LoadingScreen::setup()
+{
+  if (!m_parse.valid() && !m_decode.valid() && !m_finished)
+  {
+    m_parse = std::async(std::launch::async, &LoadingScreen::parse, m_filename);
+  }
+}
+
+std::unique_ptr<LoadingScreen::ParseResult>
+LoadingScreen::parse(const std::string& filename)
+{
+  // runs on a worker thread, so no logging and no translation here,
+  // ReaderDocument::parse(filename) would log
+  std::unique_ptr<ParseResult> result(new ParseResult);
+  {
+    IFileStreambuf ins(filename);
+    std::istream in(&ins);
+    result->doc.reset(new ReaderDocument(ReaderDocument::parse_level(in, filename)));
+  }
+
+  collect_resources(*result->doc, FileSystem::dirname(filename), *result, true);
+  return result;
+}
+
+void
+LoadingScreen::collect_resources(const ReaderDocument& doc, const std::string& basedir,
+                                 ParseResult& result, bool follow)
+{
+  for_each_string(doc.get_sexp(), [&](const std::string& str) {
+      if (is_image(str))
+      {
+        // levels refer to images relative to the data directory, while
+        // sprites use their own directory
+        result.images.push_back(follow ? str : FileSystem::join(basedir, str));
+      }
+      else if (is_sound(str))
+      {
+        result.sounds.push_back(str);
+      }
+      else if (follow && StringUtil::has_suffix(str, ".sprite"))
+      {
+        // the images of sprites the level places itself, sprites
+        // hardcoded into objects are loaded by the objects
+        try
+        {
+          IFileStreambuf ins(str);
+          std::istream in(&ins);
+          auto sprite_doc = ReaderDocument::parse(in, str);
+          collect_resources(sprite_doc, FileSystem::dirname(str), result, false);
+        }
+        catch(const std::exception&)
+        {
+          // reported by the SpriteManager later on
+        }
+      }
+    });
+}
+
+void
+LoadingScreen::start_decoding(ParseResult& result)
+{
+  // the caches are only touched on the main thread, so filter here
+  auto texture_manager = TextureManager::current();
+  for (const auto& image : result.images)
+  {
+    std::string filename = FileSystem::normalize(image);
+    if (!texture_manager->is_loaded(filename))
+      m_images.push_back(filename);
+  }
+
+  auto sound_manager = SoundManager::current();
+  if (sound_manager->is_sound_enabled())
+  {
+    for (const auto& sound : result.sounds)
+    {
+      if (!sound_manager->is_loaded(sound))
+        m_sounds.push_back(sound);
+    }
+  }
+
+  m_total = static_cast<int>(m_images.size() + m_sounds.size());
+  m_decode = std::async(std::launch::async, &LoadingScreen::decode, this);
+}
+
+void
+LoadingScreen::decode()
+{
+  for (const auto& image : m_images)
+  {
+    TextureManager::current()->preload(image);
+    ++m_done;
+  }
+
+  for (const auto& sound : m_sounds)
+  {
+    SoundManager::current()->decode(sound);
+    ++m_done;
+  }
+}
+
+void
+LoadingScreen::update(float)
+{
+  if (m_finished)
+    return;
+
+  if (m_parse.valid())
+  {
+    if (!is_ready(m_parse))
+      return;
+
+    try
+    {
+      std::unique_ptr<ParseResult> result = m_parse.get();
+      m_doc = std::move(result->doc);
+      start_decoding(*result);
+    }
+    catch(const std::exception&)
+    {
+      // let the created screen run into the error again and report it
+      m_doc.reset();
+    }
+    return;
+  }
+
+  if (m_decode.valid())
+  {
+    if (!is_ready(m_decode))
+      return;
+
+    m_decode.get();
+  }
+
+  finish();
+}
+
+void
+LoadingScreen::finish()
+{
+  m_finished = true;
+
+  // upload the sounds now, the images are uploaded by the objects that
+  // use them
+  for (const auto& sound : m_sounds)
+  {
+    SoundManager::current()->preload(sound);
+  }
+
+  std::unique_ptr<Screen> screen;
+  try
+  {
+    screen = m_create(m_doc.get());
+  }
+  catch(const std::exception& e)
+  {
+    log_fatal << "Couldn't load '" << m_filename << "': " << e.what() << std::endl;
+  }
+
+  TextureManager::current()->drop_preloaded();
+  m_doc.reset();
+
+  ScreenManager::current()->pop_screen();
+  if (screen)
+  {
+    ScreenManager::current()->push_screen(std::move(screen));
+  }
+}
+
+void
+LoadingScreen::draw(Compositor& compositor)
+{
+  auto& context = compositor.make_context();
+
+  const float width = static_cast<float>(context.get_width());
+  const float height = static_cast<float>(context.get_height());
+
+  context.color().draw_filled_rect(Vector(0, 0), Vector(width, height),
+                                   Color(0.0f, 0.0f, 0.0f, 1.0f), 0);
+
+  context.color().draw_center_text(Resources::normal_font, _("Loading..."),
+                                   Vector(0, height / 2.0f - Resources::normal_font->get_height()),
+                                   LAYER_GUI);
+
+  if (m_total > 0)
+  {
+    const float bar_width = width / 3.0f;
+    const float progress = static_cast<float>(m_done) / static_cast<float>(m_total);
+    const Vector pos((width - bar_width) / 2.0f, height / 2.0f + 8.0f);
+
+    context.color().draw_filled_rect(Rectf(pos, Sizef(bar_width, 8.0f)),
+                                     Color(0.3f, 0.3f, 0.3f, 1.0f), LAYER_GUI);
+    context.color().draw_filled_rect(Rectf(pos, Sizef(bar_width * progress, 8.0f)),
+                                     Color(1.0f, 1.0f, 1.0f, 1.0f), LAYER_GUI + 1);
+  }
+}
+
+/* EOF */
@@ -0,0 +1,88 @@
+//  SuperTux
+//  Copyright (C) 2018 SuperTux Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef HEADER_SUPERTUX_SUPERTUX_LOADING_SCREEN_HPP
+#define HEADER_SUPERTUX_SUPERTUX_LOADING_SCREEN_HPP
+
+#include <atomic>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "supertux/screen.hpp"
+
+class ReaderDocument;
+
+/**
+ * Screen that loads a level or worldmap without freezing the window.
+ * The document is parsed and the images and sounds it refers to are
+ * decoded on worker threads, while the GL/AL uploads and the object
+ * construction stay on the main thread. When everything is ready the
+ * LoadingScreen replaces itself with the Screen returned by create.
+ */
+class LoadingScreen final : public Screen
+{
+public:
+  /** doc is nullptr if parsing failed in the background, the created
+      screen should then parse the file itself to report the error */
+  typedef std::function<std::unique_ptr<Screen> (const ReaderDocument* doc)> CreateFunc;
+
+public:
+  LoadingScreen(const std::string& filename, const CreateFunc& create);
+  ~LoadingScreen();
+
+  virtual void setup() override;
+  virtual void draw(Compositor& compositor) override;
+  virtual void update(float elapsed_time) override;
+
+private:
+  struct ParseResult;
+
+  static std::unique_ptr<ParseResult> parse(const std::string& filename);
+  static void collect_resources(const ReaderDocument& doc, const std::string& basedir,
+                                ParseResult& result, bool follow);
+
+  void start_decoding(ParseResult& result);
+  void decode();
+  void finish();
+
+private:
+  std::string m_filename;
+  CreateFunc m_create;
+
+  std::future<std::unique_ptr<ParseResult> > m_parse;
+  std::future<void> m_decode;
+
+  std::unique_ptr<ReaderDocument> m_doc;
+  std::vector<std::string> m_images;
+  std::vector<std::string> m_sounds;
+
+  /** number of images and sounds decoded so far */
+  std::atomic<int> m_done;
+  int m_total;
+  bool m_finished;
+
+private:
+  LoadingScreen(const LoadingScreen&) = delete;
+  LoadingScreen& operator=(const LoadingScreen&) = delete;
+};
+
+#endif
+
+/* EOF */
@@ -49,6 +49,7 @@ extern "C" {
 #include "supertux/command_line_arguments.hpp"
 #include "supertux/console.hpp"
 #include "supertux/game_manager.hpp"
+#include "supertux/level_metadata_cache.hpp"
 #include "supertux/game_session.hpp"
 #include "supertux/gameconfig.hpp"
 #include "supertux/globals.hpp"
@@ -63,6 +64,7 @@ extern "C" {
 #include "supertux/tile_manager.hpp"
 #include "supertux/title_screen.hpp"
 #include "supertux/world.hpp"
+#include "util/binary_document.hpp"
 #include "util/file_system.hpp"
 #include "util/gettext.hpp"
 #include "worldmap/worldmap.hpp"
@@ -90,7 +92,8 @@ public:
 
   ~ConfigSubsystem()
   {
-    if (g_config)
+    // --benchmark overrides video and sound settings, don't keep them
+    if (g_config && !g_config->benchmark)
     {
       try
       {
@@ -302,6 +305,12 @@ class SDLSubsystem
 public:
   SDLSubsystem()
   {
+    if(g_config->benchmark)
+    {
+      // no window is opened, so don't require a display either
+      SDL_setenv("SDL_VIDEODRIVER", "dummy", 0);
+    }
+
     if(SDL_Init(SDL_INIT_TIMER | SDL_INIT_VIDEO | SDL_INIT_JOYSTICK | SDL_INIT_GAMECONTROLLER) < 0)
     {
       std::stringstream msg;
@@ -395,6 +404,7 @@ Main::launch_game()
 
   const std::unique_ptr<Savegame> default_savegame(new Savegame(std::string()));
 
+  LevelMetadataCache level_metadata_cache;
   GameManager game_manager;
   ScreenManager screen_manager(*video_system);
 
@@ -523,6 +533,10 @@ Main::run(int argc, char** argv)
         args.print_datadir();
         return 0;
 
+      case CommandLineArguments::CONVERT_LEVEL:
+        BinaryDocument::convert(*args.convert_input, *args.convert_output);
+        return 0;
+
       default:
         launch_game();
         break;
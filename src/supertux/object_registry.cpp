@@ -0,0 +1,52 @@
+//  SuperTux
+//  Copyright (C) 2018 SuperTux Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "supertux/object_registry.hpp"
+
+#include <algorithm>
+
+ObjectRegistry::ObjectRegistry() :
+  m_buckets()
+{
+}
+
+void
+ObjectRegistry::add(GameObject* object)
+{
+  for(auto& it : m_buckets) {
+    Bucket& bucket = it.second;
+    void* ptr = bucket.cast(object);
+    if(ptr)
+      bucket.objects.push_back(ptr);
+  }
+}
+
+void
+ObjectRegistry::remove(GameObject* object)
+{
+  for(auto& it : m_buckets) {
+    Bucket& bucket = it.second;
+    void* ptr = bucket.cast(object);
+    if(!ptr)
+      continue;
+
+    auto i = std::find(bucket.objects.begin(), bucket.objects.end(), ptr);
+    if(i != bucket.objects.end())
+      bucket.objects.erase(i);
+  }
+}
+
+/* EOF */
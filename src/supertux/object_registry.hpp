@@ -0,0 +1,120 @@
+//  SuperTux
+//  Copyright (C) 2018 SuperTux Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_SUPERTUX_OBJECT_REGISTRY_HPP
+#define HEADER_SUPERTUX_SUPERTUX_OBJECT_REGISTRY_HPP
+
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+#include "supertux/game_object.hpp"
+#include "supertux/game_object_ptr.hpp"
+
+/**
+ * Keeps per-type lists of the GameObjects of a Sector, so that queries
+ * like "all BadGuys" don't have to dynamic_cast every object in the
+ * sector. A list for a type is created on the first query for that
+ * type and is kept up to date by add() and remove() afterwards, which
+ * also makes queries for base classes and interfaces work.
+ */
+class ObjectRegistry final
+{
+public:
+  /** Typed view of the objects of one type, valid until the next add() or remove() */
+  template<class T>
+  class Range
+  {
+  public:
+    class iterator
+    {
+    public:
+      iterator(std::vector<void*>::const_iterator it) : m_it(it) {}
+
+      T* operator*() const { return static_cast<T*>(*m_it); }
+      iterator& operator++() { ++m_it; return *this; }
+      bool operator!=(const iterator& rhs) const { return m_it != rhs.m_it; }
+      bool operator==(const iterator& rhs) const { return m_it == rhs.m_it; }
+
+    private:
+      std::vector<void*>::const_iterator m_it;
+    };
+
+  public:
+    Range(const std::vector<void*>& objects) : m_objects(objects) {}
+
+    iterator begin() const { return iterator(m_objects.begin()); }
+    iterator end() const { return iterator(m_objects.end()); }
+    size_t size() const { return m_objects.size(); }
+    bool empty() const { return m_objects.empty(); }
+
+  private:
+    const std::vector<void*>& m_objects;
+  };
+
+public:
+  ObjectRegistry();
+
+  void add(GameObject* object);
+  void remove(GameObject* object);
+
+  /** Returns all objects of type T, objects is used to fill the list
+      on the first query for T */
+  template<class T>
+  Range<T> get(const std::vector<GameObjectPtr>& objects)
+  {
+    auto it = m_buckets.find(std::type_index(typeid(T)));
+    if(it == m_buckets.end()) {
+      Bucket& bucket = m_buckets[std::type_index(typeid(T))];
+      bucket.cast = &cast_object<T>;
+      for(const auto& object : objects) {
+        void* ptr = bucket.cast(object.get());
+        if(ptr)
+          bucket.objects.push_back(ptr);
+      }
+      return Range<T>(bucket.objects);
+    }
+    return Range<T>(it->second.objects);
+  }
+
+private:
+  typedef void* (*CastFunc)(GameObject*);
+
+  struct Bucket
+  {
+    Bucket() : cast(), objects() {}
+
+    CastFunc cast;
+    std::vector<void*> objects;
+  };
+
+  template<class T>
+  static void* cast_object(GameObject* object)
+  {
+    return dynamic_cast<T*>(object);
+  }
+
+private:
+  std::unordered_map<std::type_index, Bucket> m_buckets;
+
+private:
+  ObjectRegistry(const ObjectRegistry&) = delete;
+  ObjectRegistry& operator=(const ObjectRegistry&) = delete;
+};
+
+#endif
+
+/* EOF */
@@ -22,6 +22,7 @@
 #include "gui/menu_manager.hpp"
 #include "scripting/scripting.hpp"
 #include "scripting/time_scheduler.hpp"
+#include "supertux/benchmark.hpp"
 #include "supertux/console.hpp"
 #include "supertux/constants.hpp"
 #include "supertux/gameconfig.hpp"
@@ -30,9 +31,11 @@
 #include "supertux/resources.hpp"
 #include "supertux/screen_fade.hpp"
 #include "supertux/sector.hpp"
+#include "util/profiler.hpp"
 #include "video/compositor.hpp"
 #include "video/drawing_context.hpp"
 
+#include <iostream>
 #include <stdio.h>
 
 /** ticks (as returned from SDL_GetTicks) per frame */
@@ -49,10 +52,28 @@ ScreenManager::ScreenManager(VideoSystem& video_system) :
   m_actions(),
   m_fps(0),
   m_screen_fade(),
-  m_screen_stack()
+  m_screen_stack(),
+  m_profiler(),
+  m_benchmark()
 {
   using namespace scripting;
   TimeScheduler::instance = new TimeScheduler();
+
+  if (g_config->show_profiler || !g_config->profile_trace.empty() || g_config->benchmark)
+  {
+    m_profiler.reset(new Profiler);
+    if (!g_config->profile_trace.empty())
+    {
+      try
+      {
+        m_profiler->open_trace(g_config->profile_trace);
+      }
+      catch(const std::exception& err)
+      {
+        log_warning << err.what() << std::endl;
+      }
+    }
+  }
 }
 
 ScreenManager::~ScreenManager()
@@ -147,6 +168,35 @@ ScreenManager::draw_player_pos(DrawingContext& context)
   }
 }
 
+void
+ScreenManager::draw_profiler(DrawingContext& context)
+{
+  const float budget = 1000.0f / LOGICAL_FPS;
+  const float line_height = Resources::small_font->get_height() + 2.0f;
+  const float right = static_cast<float>(context.get_width()) - BORDER_X;
+  const float left = right - Resources::small_font->get_text_width("update_game_objects 99.99 / 99.99 ms") - 20.0f;
+
+  Vector pos(left, BORDER_Y + 60.0f);
+  context.color().draw_text(Resources::small_font, "avg / peak ms",
+                            Vector(right, pos.y), ALIGN_RIGHT, LAYER_HUD);
+  pos.y += line_height;
+
+  for(const auto& entry : m_profiler->get_entries())
+  {
+    char str[60];
+    snprintf(str, sizeof(str), "%.2f / %.2f", entry.average, entry.peak);
+
+    // mark the phases that alone blow the budget of a logical frame
+    Color color = (entry.peak > budget) ? Color(1.0f, 0.5f, 0.5f) : Color(1.0f, 1.0f, 1.0f);
+
+    context.color().draw_text(Resources::small_font, std::string(entry.depth * 2, ' ') + entry.name,
+                              Vector(left, pos.y), ALIGN_LEFT, LAYER_HUD, color);
+    context.color().draw_text(Resources::small_font, str,
+                              Vector(right, pos.y), ALIGN_RIGHT, LAYER_HUD, color);
+    pos.y += line_height;
+  }
+}
+
 void
 ScreenManager::draw(Compositor& compositor)
 {
@@ -178,8 +228,16 @@ ScreenManager::draw(Compositor& compositor)
     draw_player_pos(context);
   }
 
+  if (m_profiler && g_config->show_profiler)
+  {
+    draw_profiler(context);
+  }
+
   // render everything
-  compositor.render();
+  {
+    ProfileScope scope("Compositor::render");
+    compositor.render();
+  }
 
   /* Calculate frames per second */
   if (g_config->show_fps)
@@ -376,6 +434,11 @@ ScreenManager::run()
   Uint32 last_ticks = 0;
   Uint32 elapsed_ticks = 0;
 
+  if (g_config->benchmark)
+  {
+    m_benchmark.reset(new Benchmark);
+  }
+
   handle_screen_switch();
 
   while (!m_screen_stack.empty())
@@ -388,13 +451,19 @@ ScreenManager::run()
 
     if (elapsed_ticks > ticks_per_frame*4)
     {
-      // when the game loads up or levels are switched the
-      // elapsed_ticks grows extremely large, so we just ignore those
-      // large time jumps
+      // when the game loads up or a screen is constructed
+      // synchronously the elapsed_ticks grows extremely large, so we
+      // just ignore those large time jumps, levels and worldmaps are
+      // loaded through the LoadingScreen and don't stall anymore
       elapsed_ticks = 0;
     }
 
-    if (elapsed_ticks < ticks_per_frame)
+    if (m_benchmark)
+    {
+      // no pacing, exactly one logical frame per drawn frame
+      elapsed_ticks = ticks_per_frame;
+    }
+    else if (elapsed_ticks < ticks_per_frame)
     {
       Uint32 delay_ticks = ticks_per_frame - elapsed_ticks;
       SDL_Delay(delay_ticks);
@@ -404,6 +473,11 @@ ScreenManager::run()
 
     int frames = 0;
 
+    if (m_profiler)
+    {
+      m_profiler->begin_frame();
+    }
+
     while (elapsed_ticks >= ticks_per_frame && frames < MAX_FRAME_SKIP)
     {
       elapsed_ticks -= ticks_per_frame;
@@ -412,20 +486,47 @@ ScreenManager::run()
       timestep *= m_speed;
       game_time += timestep;
 
-      process_events();
-      update_gamelogic(timestep);
+      {
+        ProfileScope scope("process_events");
+        process_events();
+      }
+      {
+        ProfileScope scope("update_gamelogic");
+        update_gamelogic(timestep);
+      }
+      if (m_benchmark)
+      {
+        m_benchmark->update();
+      }
       frames += 1;
     }
 
     if (!m_screen_stack.empty())
     {
+      ProfileScope scope("draw");
       Compositor compositor(m_video_system);
       draw(compositor);
     }
 
-    SoundManager::current()->update();
+    {
+      ProfileScope scope("SoundManager::update");
+      SoundManager::current()->update();
+    }
+
+    {
+      ProfileScope scope("handle_screen_switch");
+      handle_screen_switch();
+    }
+
+    if (m_profiler)
+    {
+      m_profiler->end_frame();
+    }
+  }
 
-    handle_screen_switch();
+  if (m_benchmark)
+  {
+    m_benchmark->print_report(std::cout);
   }
 }
 
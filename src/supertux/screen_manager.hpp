@@ -24,10 +24,12 @@
 #include "supertux/screen.hpp"
 #include "util/currenton.hpp"
 
+class Benchmark;
 class Compositor;
 class DrawingContext;
 class MenuManager;
 class MenuStorage;
+class Profiler;
 class ScreenFade;
 class VideoSystem;
 
@@ -57,6 +59,7 @@ public:
 private:
   void draw_fps(DrawingContext& context, float fps);
   void draw_player_pos(DrawingContext& context);
+  void draw_profiler(DrawingContext& context);
   void draw(Compositor& compositor);
   void update_gamelogic(float elapsed_time);
   void process_events();
@@ -87,6 +90,12 @@ private:
   float m_fps;
   std::unique_ptr<ScreenFade> m_screen_fade;
   std::vector<std::unique_ptr<Screen> > m_screen_stack;
+
+  /// only created when the overlay or a trace file is requested
+  std::unique_ptr<Profiler> m_profiler;
+
+  /// only created for --benchmark
+  std::unique_ptr<Benchmark> m_benchmark;
 };
 
 #endif
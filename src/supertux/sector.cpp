@@ -41,6 +41,7 @@
 #include "supertux/spawn_point.hpp"
 #include "supertux/tile.hpp"
 #include "util/file_system.hpp"
+#include "util/profiler.hpp"
 #include "util/writer.hpp"
 #include "video/video_system.hpp"
 #include "video/viewport.hpp"
@@ -66,6 +67,9 @@ Sector::Sector(Level* parent) :
   ambient_light_fade_duration(0.0f),
   ambient_light_fade_accum(0.0f),
   foremost_layer(),
+  collision_grid(),
+  collision_candidates(),
+  object_registry(),
   gameobjects(),
   moving_objects(),
   spawnpoints(),
@@ -223,10 +227,7 @@ Sector::activate(const Vector& player_pos)
 
   // two-player hack: move other players to main player's position
   // Maybe specify 2 spawnpoints in the level?
-  for(auto& object : gameobjects) {
-    auto p = dynamic_cast<Player*>(object.get());
-    if (!p) continue;
-
+  for(auto p : get_objects_by_type<Player>()) {
     // spawn smalltux below spawnpoint
     if (!p->is_big()) {
       p->move(player_pos + Vector(0,32));
@@ -305,10 +306,8 @@ int
 Sector::calculate_foremost_layer() const
 {
   int layer = LAYER_BACKGROUND0;
-  for(const auto& obj : gameobjects)
+  for(const auto& tm : get_objects_by_type<TileMap>())
   {
-    const auto& tm = dynamic_cast<TileMap*>(obj.get());
-    if (!tm) continue;
     if(tm->get_layer() > layer)
     {
       if( (tm->get_alpha() < 1.0) )
@@ -334,6 +333,8 @@ Sector::get_foremost_layer() const
 void
 Sector::update(float elapsed_time)
 {
+  ProfileScope scope("Sector::update");
+
   player->check_bounds();
 
   if(ambient_light_fading)
@@ -369,16 +370,25 @@ Sector::update(float elapsed_time)
   }
 
   /* update objects */
-  for(const auto& object : gameobjects) {
-    if(!object->is_valid())
-      continue;
+  {
+    ProfileScope scope("update objects");
+    for(const auto& object : gameobjects) {
+      if(!object->is_valid())
+        continue;
 
-    object->update(elapsed_time);
+      object->update(elapsed_time);
+    }
   }
 
   /* Handle all possible collisions. */
-  handle_collisions();
-  update_game_objects();
+  {
+    ProfileScope scope("handle_collisions");
+    handle_collisions();
+  }
+  {
+    ProfileScope scope("update_game_objects");
+    update_game_objects();
+  }
 }
 
 void
@@ -407,22 +417,13 @@ Sector::update_game_objects()
     gameobjects.push_back(object);
   }
   gameobjects_new.clear();
-
-  /* update solid_tilemaps list */
-  //FIXME: this could be more efficient
-  solid_tilemaps.clear();
-  for(const auto& obj : gameobjects)
-  {
-    const auto& tm = dynamic_cast<TileMap*>(obj.get());
-    if (!tm) continue;
-    if (tm->is_solid()) solid_tilemaps.push_back(tm);
-  }
-
 }
 
 bool
 Sector::before_object_add(GameObjectPtr object)
 {
+  object_registry.add(object.get());
+
   auto bullet = dynamic_cast<Bullet*>(object.get());
   if (bullet)
   {
@@ -442,8 +443,11 @@ Sector::before_object_add(GameObjectPtr object)
   }
 
   auto tilemap = dynamic_cast<TileMap*>(object.get());
-  if(tilemap && tilemap->is_solid()) {
-    solid_tilemaps.push_back(tilemap);
+  if(tilemap) {
+    tilemap->set_sector(this);
+    if(tilemap->is_solid()) {
+      solid_tilemaps.push_back(tilemap);
+    }
   }
 
   auto camera_ = dynamic_cast<Camera*>(object.get());
@@ -499,6 +503,8 @@ Sector::try_expose_me()
 void
 Sector::before_object_remove(GameObjectPtr object)
 {
+  object_registry.remove(object.get());
+
   auto portable = dynamic_cast<Portable*>(object.get());
   if (portable) {
     portables.erase(std::find(portables.begin(), portables.end(), portable));
@@ -512,11 +518,29 @@ Sector::before_object_remove(GameObjectPtr object)
     moving_objects.erase(
       std::find(moving_objects.begin(), moving_objects.end(), moving_object));
   }
+  auto tilemap = dynamic_cast<TileMap*>(object.get());
+  if (tilemap) {
+    solid_tilemaps.remove(tilemap);
+    tilemap->set_sector(NULL);
+  }
 
   if(_current == this)
     try_unexpose(object);
 }
 
+void
+Sector::on_tilemap_solidity_change(TileMap* tilemap)
+{
+  auto it = std::find(solid_tilemaps.begin(), solid_tilemaps.end(), tilemap);
+  if(tilemap->is_solid()) {
+    if(it == solid_tilemaps.end())
+      solid_tilemaps.push_back(tilemap);
+  } else {
+    if(it != solid_tilemaps.end())
+      solid_tilemaps.erase(it);
+  }
+}
+
 void
 Sector::try_unexpose(GameObjectPtr object)
 {
@@ -672,15 +696,22 @@ Sector::collision_tilemap(collision::Constraints* constraints,
 
     for(int x = test_tiles.left; x < test_tiles.right; ++x) {
       for(int y = test_tiles.top; y < test_tiles.bottom; ++y) {
-        const auto& tile = solids->get_tile(x, y);
-        if(!tile)
-          continue;
+        uint8_t flags = solids->get_tile_flags(x, y);
         // skip non-solid tiles
-        if(!tile->is_solid ())
+        if(!(flags & TileMap::FLAG_SOLID))
           continue;
         Rectf tile_bbox = solids->get_tile_bbox(x, y);
 
-        /* If the tile is a unisolid tile, the "is_solid()" function above
+        // plain solid tiles don't need to look at the Tile itself
+        if(!(flags & (TileMap::FLAG_UNISOLID | TileMap::FLAG_SLOPE))) {
+          check_collisions(constraints, movement, dest, tile_bbox, NULL, NULL,
+              solids->get_movement(/* actual = */ false));
+          continue;
+        }
+
+        const auto& tile = solids->get_tile(x, y);
+
+        /* If the tile is a unisolid tile, the FLAG_SOLID check above
          * didn't do a thorough check. Calculate the position and (relative)
          * movement of the object and determine whether or not the tile is
          * solid with regard to those parameters. */
@@ -728,6 +759,8 @@ Sector::collision_tile_attributes(const Rectf& dest, const Vector& mov) const
     for(int x = test_tiles.left; x < test_tiles.right; ++x) {
       int y;
       for(y = test_tiles.top; y < test_tiles.bottom; ++y) {
+        if(!(solids->get_tile_flags(x, y) & TileMap::FLAG_ATTRIBUTES))
+          continue;
         const auto& tile = solids->get_tile(x, y);
         if(!tile)
           continue;
@@ -736,6 +769,8 @@ Sector::collision_tile_attributes(const Rectf& dest, const Vector& mov) const
         }
       }
       for(; y < test_tiles_ice.bottom; ++y) {
+        if(!(solids->get_tile_flags(x, y) & TileMap::FLAG_ICE))
+          continue;
         const auto& tile = solids->get_tile(x, y);
         if(!tile)
           continue;
@@ -1009,13 +1044,22 @@ Sector::handle_collisions()
   }
 
   // part2.5: COLGROUP_MOVING vs COLGROUP_TOUCHABLE
+  collision_grid.clear();
+  for(size_t i = 0; i < moving_objects.size(); ++i) {
+    if(moving_objects[i]->get_group() == COLGROUP_TOUCHABLE)
+      collision_grid.insert(static_cast<int>(i), moving_objects[i]->dest);
+  }
+
   for(const auto& moving_object : moving_objects) {
     if((moving_object->get_group() != COLGROUP_MOVING
         && moving_object->get_group() != COLGROUP_MOVING_STATIC)
        || !moving_object->is_valid())
       continue;
 
-    for(auto& moving_object_2 : moving_objects) {
+    // candidates are sorted, so they are visited in moving_objects order
+    collision_grid.query(moving_object->dest, collision_candidates);
+    for(const auto& index : collision_candidates) {
+      auto moving_object_2 = moving_objects[index];
       if(moving_object_2->get_group() != COLGROUP_TOUCHABLE
          || !moving_object_2->is_valid())
         continue;
@@ -1037,23 +1081,37 @@ Sector::handle_collisions()
   }
 
   // part3: COLGROUP_MOVING vs COLGROUP_MOVING
-  for(auto i = moving_objects.begin(); i != moving_objects.end(); ++i) {
-    auto moving_object = *i;
+  collision_grid.clear();
+  for(size_t i = 0; i < moving_objects.size(); ++i) {
+    if(moving_objects[i]->get_group() == COLGROUP_MOVING
+       || moving_objects[i]->get_group() == COLGROUP_MOVING_STATIC)
+      collision_grid.insert(static_cast<int>(i), moving_objects[i]->dest);
+  }
+
+  for(size_t i = 0; i < moving_objects.size(); ++i) {
+    auto moving_object = moving_objects[i];
 
     if((moving_object->get_group() != COLGROUP_MOVING
         && moving_object->get_group() != COLGROUP_MOVING_STATIC)
        || !moving_object->is_valid())
       continue;
 
-    for(auto i2 = i+1; i2 != moving_objects.end(); ++i2) {
-      auto moving_object_2 = *i2;
-      if((moving_object_2->get_group() != COLGROUP_MOVING
-          && moving_object_2->get_group() != COLGROUP_MOVING_STATIC)
-         || !moving_object_2->is_valid())
-        continue;
+    // every pair is handled once, by the object that comes first.
+    // collision_object() pushes dest around, the grid follows it so
+    // pairs that only overlap after a push are still found
+    collision_grid.query_following(
+      static_cast<int>(i),
+      [this](int index) { return moving_objects[index]->dest; },
+      [this, &moving_object](int index) {
+        auto moving_object_2 = moving_objects[index];
+        if((moving_object_2->get_group() != COLGROUP_MOVING
+            && moving_object_2->get_group() != COLGROUP_MOVING_STATIC)
+           || !moving_object_2->is_valid())
+          return;
 
-      collision_object(moving_object, moving_object_2);
-    }
+        collision_object(moving_object, moving_object_2);
+      },
+      collision_candidates);
   }
 
   // apply object movement
@@ -1074,13 +1132,13 @@ Sector::is_free_of_tiles(const Rectf& rect, const bool ignoreUnisolid) const
 
     for(int x = test_tiles.left; x < test_tiles.right; ++x) {
       for(int y = test_tiles.top; y < test_tiles.bottom; ++y) {
-        const auto& tile = solids->get_tile(x, y);
-        if(!tile) continue;
-        if(!(tile->getAttributes() & Tile::SOLID))
+        uint8_t flags = solids->get_tile_flags(x, y);
+        if(!(flags & TileMap::FLAG_SOLID))
           continue;
-        if(tile->is_unisolid () && ignoreUnisolid)
+        if((flags & TileMap::FLAG_UNISOLID) && ignoreUnisolid)
           continue;
-        if(tile->is_slope ()) {
+        if(flags & TileMap::FLAG_SLOPE) {
+          const auto& tile = solids->get_tile(x, y);
           AATriangle triangle;
           Rectf tbbox = solids->get_tile_bbox(x, y);
           triangle = AATriangle(tbbox, tile->getData());
@@ -1237,9 +1295,8 @@ int
 Sector::get_total_badguys() const
 {
   int total_badguys = 0;
-  for(const auto& object : gameobjects) {
-    auto badguy = dynamic_cast<BadGuy*>(object.get());
-    if (badguy && badguy->countMe)
+  for(const auto& badguy : get_objects_by_type<BadGuy>()) {
+    if (badguy->countMe)
       total_badguys++;
   }
 
@@ -22,7 +22,9 @@
 #include <stdint.h>
 
 #include "object/anchor_point.hpp"
+#include "supertux/collision_grid.hpp"
 #include "supertux/game_object_ptr.hpp"
+#include "supertux/object_registry.hpp"
 #include "video/color.hpp"
 
 namespace collision {
@@ -129,14 +131,16 @@ public:
   /** Get total number of badguys */
   int get_total_badguys() const;
 
+  /** Get all GameObjects of given type */
+  template<class T> ObjectRegistry::Range<T> get_objects_by_type() const
+  {
+    return object_registry.get<T>(gameobjects);
+  }
+
   /** Get total number of GameObjects of given type */
   template<class T> int get_total_count() const
   {
-    int total = 0;
-    for(const auto& obj : gameobjects) {
-      if (dynamic_cast<T*>(obj.get())) total++;
-    }
-    return total;
+    return static_cast<int>(get_objects_by_type<T>().size());
   }
 
   void collision_tilemap(collision::Constraints* constraints,
@@ -204,6 +208,12 @@ public:
    */
   void resize_sector(const Size& old_size, const Size& new_size, const Size& resize_offset);
 
+  /**
+   * Called by TileMaps of this sector whenever is_solid() changes,
+   * keeps solid_tilemaps up to date
+   */
+  void on_tilemap_solidity_change(TileMap* tilemap);
+
   /**
    * globally changes solid tilemaps' tile ids
    */
@@ -332,6 +342,13 @@ private:
 
   int foremost_layer;
 
+  /// broadphase for the object vs object passes of handle_collisions()
+  CollisionGrid collision_grid;
+  std::vector<int> collision_candidates;
+
+  /// per-type lists of gameobjects, see get_objects_by_type()
+  mutable ObjectRegistry object_registry;
+
 public: // TODO make this private again
   /// show collision rectangles of moving objects (for debugging)
   static bool show_collrects;
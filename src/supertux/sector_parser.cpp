@@ -336,10 +336,7 @@ void
 SectorParser::fix_old_tiles()
 {
   // add lights for special tiles
-  for(const auto& obj : m_sector.gameobjects) {
-    auto tm = dynamic_cast<TileMap*>(obj.get());
-    if (!tm) continue;
-
+  for(const auto& tm : m_sector.get_objects_by_type<TileMap>()) {
     for(int x=0; x < tm->get_width(); ++x)
     {
       for(int y=0; y < tm->get_height(); ++y)
@@ -133,6 +133,10 @@ public:
 
   SurfacePtr get_current_surface() const;
 
+  /** Returns true if the image of the tile changes over time */
+  bool is_animated() const
+  { return images.size() > 1; }
+
   uint32_t getAttributes() const
   { return attributes; }
 
@@ -0,0 +1,605 @@
+//  SuperTux
+//  Copyright (C) 2018 SuperTux Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "util/binary_document.hpp"
+
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <sexp/value.hpp>
+#include <sstream>
+#include <stdexcept>
+#include <stdint.h>
+#include <string.h>
+#include <unordered_map>
+#include <vector>
+
+#include "util/log.hpp"
+#include "util/reader_document.hpp"
+
+namespace {
+
+const char MAGIC[4] = { 'S', 'T', 'L', 'B' };
+const uint32_t VERSION = 1;
+
+// limits that keep damaged files from overflowing the stack or
+// allocating absurd amounts of memory
+const int MAX_DEPTH = 256;
+const uint32_t MAX_INT_ARRAY_SIZE = 1 << 26;
+
+enum Tag : uint8_t
+{
+  TAG_NIL,
+  TAG_FALSE,
+  TAG_TRUE,
+  TAG_INTEGER,
+  TAG_REAL,
+  TAG_STRING,
+  TAG_SYMBOL,
+  TAG_ARRAY,
+  TAG_INT_ARRAY,
+  TAG_INT_ARRAY_RLE
+};
+
+void append_u32(std::string& buf, uint32_t value)
+{
+  buf.push_back(static_cast<char>(value & 0xff));
+  buf.push_back(static_cast<char>((value >> 8) & 0xff));
+  buf.push_back(static_cast<char>((value >> 16) & 0xff));
+  buf.push_back(static_cast<char>((value >> 24) & 0xff));
+}
+
+class Encoder final
+{
+public:
+  Encoder(const ReaderDocument& doc) :
+    m_doc(doc),
+    m_strings(),
+    m_string_indices(),
+    m_body()
+  {}
+
+  void encode(const sexp::Value& sx)
+  {
+    switch(sx.get_type())
+    {
+      case sexp::Value::TYPE_NIL:
+        put_u8(TAG_NIL);
+        break;
+
+      case sexp::Value::TYPE_BOOLEAN:
+        put_u8(sx.as_bool() ? TAG_TRUE : TAG_FALSE);
+        break;
+
+      case sexp::Value::TYPE_INTEGER:
+        put_u8(TAG_INTEGER);
+        append_u32(m_body, static_cast<uint32_t>(sx.as_int()));
+        break;
+
+      case sexp::Value::TYPE_REAL:
+      {
+        float value = sx.as_float();
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        put_u8(TAG_REAL);
+        append_u32(m_body, bits);
+        break;
+      }
+
+      case sexp::Value::TYPE_STRING:
+        put_u8(TAG_STRING);
+        append_u32(m_body, get_string_index(sx.as_string()));
+        break;
+
+      case sexp::Value::TYPE_SYMBOL:
+        put_u8(TAG_SYMBOL);
+        append_u32(m_body, get_string_index(sx.as_string()));
+        break;
+
+      case sexp::Value::TYPE_ARRAY:
+      {
+        auto const& arr = sx.as_array();
+        auto const values = m_doc.get_int_array(sx);
+        if (values && arr[0].is_symbol())
+        {
+          encode_int_array(arr[0].as_string(), *values);
+        }
+        else
+        {
+          put_u8(TAG_ARRAY);
+          append_u32(m_body, static_cast<uint32_t>(arr.size()));
+          for(const auto& item : arr)
+            encode(item);
+        }
+        break;
+      }
+
+      default:
+        throw std::runtime_error("value can't be stored in a binary document");
+    }
+  }
+
+  void finish(std::ostream& out) const
+  {
+    std::string header(MAGIC, sizeof(MAGIC));
+    append_u32(header, VERSION);
+
+    append_u32(header, static_cast<uint32_t>(m_strings.size()));
+    for(const auto& str : m_strings)
+    {
+      append_u32(header, static_cast<uint32_t>(str.size()));
+      header += str;
+    }
+
+    out.write(header.data(), header.size());
+    out.write(m_body.data(), m_body.size());
+  }
+
+private:
+  void put_u8(uint8_t value)
+  {
+    m_body.push_back(static_cast<char>(value));
+  }
+
+  uint32_t get_string_index(const std::string& str)
+  {
+    auto it = m_string_indices.find(str);
+    if (it != m_string_indices.end())
+      return it->second;
+
+    uint32_t index = static_cast<uint32_t>(m_strings.size());
+    m_strings.push_back(str);
+    m_string_indices[str] = index;
+    return index;
+  }
+
+  void encode_int_array(const std::string& key, const std::vector<uint32_t>& values)
+  {
+    size_t runs = 0;
+    for(size_t i = 0; i < values.size(); ++i)
+    {
+      if (i == 0 || values[i] != values[i - 1])
+        runs += 1;
+    }
+
+    // tilemaps are mostly empty, so this usually wins by a lot
+    bool rle = runs * 2 < values.size();
+
+    put_u8(rle ? TAG_INT_ARRAY_RLE : TAG_INT_ARRAY);
+    append_u32(m_body, get_string_index(key));
+    append_u32(m_body, static_cast<uint32_t>(values.size()));
+
+    if (!rle)
+    {
+      for(const auto& value : values)
+        append_u32(m_body, value);
+    }
+    else
+    {
+      append_u32(m_body, static_cast<uint32_t>(runs));
+      size_t start = 0;
+      for(size_t i = 1; i <= values.size(); ++i)
+      {
+        if (i == values.size() || values[i] != values[start])
+        {
+          append_u32(m_body, static_cast<uint32_t>(i - start));
+          append_u32(m_body, values[start]);
+          start = i;
+        }
+      }
+    }
+  }
+
+private:
+  const ReaderDocument& m_doc;
+  std::vector<std::string> m_strings;
+  std::unordered_map<std::string, uint32_t> m_string_indices;
+  std::string m_body;
+
+private:
+  Encoder(const Encoder&) = delete;
+  Encoder& operator=(const Encoder&) = delete;
+};
+
+class Decoder final
+{
+public:
+  Decoder(const std::string& data, const std::string& filename) :
+    m_data(data),
+    m_filename(filename),
+    m_pos(0),
+    m_strings(),
+    m_int_arrays()
+  {}
+
+  ReaderDocument decode()
+  {
+    need(sizeof(MAGIC));
+    if (memcmp(m_data.data(), MAGIC, sizeof(MAGIC)) != 0)
+      error("not a binary document");
+    m_pos += sizeof(MAGIC);
+
+    uint32_t version = get_u32();
+    if (version != VERSION)
+    {
+      std::ostringstream msg;
+      msg << "unsupported version " << version;
+      error(msg.str());
+    }
+
+    uint32_t string_count = get_u32();
+    need(static_cast<uint64_t>(string_count) * 4);
+    m_strings.reserve(string_count);
+    for(uint32_t i = 0; i < string_count; ++i)
+    {
+      uint32_t len = get_u32();
+      need(len);
+      m_strings.push_back(m_data.substr(m_pos, len));
+      m_pos += len;
+    }
+
+    sexp::Value sx = decode_value(0);
+    if (m_pos != m_data.size())
+      error("trailing data");
+
+    return ReaderDocument(m_filename, std::move(sx), std::move(m_int_arrays));
+  }
+
+private:
+  sexp::Value decode_value(int depth)
+  {
+    if (depth > MAX_DEPTH)
+      error("nested too deep");
+
+    uint8_t tag = get_u8();
+    switch(tag)
+    {
+      case TAG_NIL:
+        return sexp::Value::nil();
+
+      case TAG_FALSE:
+        return sexp::Value::boolean(false);
+
+      case TAG_TRUE:
+        return sexp::Value::boolean(true);
+
+      case TAG_INTEGER:
+        return sexp::Value::integer(static_cast<int>(get_u32()));
+
+      case TAG_REAL:
+      {
+        uint32_t bits = get_u32();
+        float value;
+        memcpy(&value, &bits, sizeof(value));
+        return sexp::Value::real(value);
+      }
+
+      case TAG_STRING:
+        return sexp::Value::string(get_string());
+
+      case TAG_SYMBOL:
+        return sexp::Value::symbol(get_string());
+
+      case TAG_ARRAY:
+      {
+        uint32_t count = get_u32();
+        // every item takes at least one byte
+        need(count);
+
+        std::vector<sexp::Value> arr;
+        arr.reserve(count);
+        for(uint32_t i = 0; i < count; ++i)
+          arr.push_back(decode_value(depth + 1));
+        return sexp::Value::array(std::move(arr));
+      }
+
+      case TAG_INT_ARRAY:
+      case TAG_INT_ARRAY_RLE:
+      {
+        const std::string& key = get_string();
+        uint32_t count = get_u32();
+        if (count > MAX_INT_ARRAY_SIZE)
+          error("integer array too large");
+
+        std::vector<uint32_t> values;
+        if (tag == TAG_INT_ARRAY)
+        {
+          need(static_cast<uint64_t>(count) * 4);
+          values.reserve(count);
+          for(uint32_t i = 0; i < count; ++i)
+            values.push_back(get_u32());
+        }
+        else
+        {
+          uint32_t runs = get_u32();
+          need(static_cast<uint64_t>(runs) * 8);
+          values.reserve(count);
+          for(uint32_t i = 0; i < runs; ++i)
+          {
+            uint32_t len = get_u32();
+            uint32_t value = get_u32();
+            if (len > count - values.size())
+              error("run-length encoded array too long");
+            values.insert(values.end(), len, value);
+          }
+          if (values.size() != count)
+            error("run-length encoded array too short");
+        }
+
+        size_t index = m_int_arrays.size();
+        m_int_arrays.push_back(std::move(values));
+        return ReaderDocument::make_int_array_ref(key, index);
+      }
+
+      default:
+        error("unknown tag");
+    }
+  }
+
+  const std::string& get_string()
+  {
+    uint32_t index = get_u32();
+    if (index >= m_strings.size())
+      error("string index out of range");
+    return m_strings[index];
+  }
+
+  uint8_t get_u8()
+  {
+    need(1);
+    return static_cast<uint8_t>(m_data[m_pos++]);
+  }
+
+  uint32_t get_u32()
+  {
+    need(4);
+    uint32_t value =
+      static_cast<uint32_t>(static_cast<uint8_t>(m_data[m_pos + 0])) |
+      static_cast<uint32_t>(static_cast<uint8_t>(m_data[m_pos + 1])) << 8 |
+      static_cast<uint32_t>(static_cast<uint8_t>(m_data[m_pos + 2])) << 16 |
+      static_cast<uint32_t>(static_cast<uint8_t>(m_data[m_pos + 3])) << 24;
+    m_pos += 4;
+    return value;
+  }
+
+  void need(uint64_t size) const
+  {
+    if (size > m_data.size() - m_pos)
+      error("unexpected end of data");
+  }
+
+  [[noreturn]] void error(const std::string& msg) const
+  {
+    std::ostringstream out;
+    out << m_filename << ": damaged binary document at byte " << m_pos << ": " << msg;
+    throw std::runtime_error(out.str());
+  }
+
+private:
+  const std::string& m_data;
+  std::string m_filename;
+  size_t m_pos;
+  std::vector<std::string> m_strings;
+  std::vector<std::vector<uint32_t> > m_int_arrays;
+
+private:
+  Decoder(const Decoder&) = delete;
+  Decoder& operator=(const Decoder&) = delete;
+};
+
+void write_escaped_string(std::ostream& out, const std::string& str)
+{
+  out << '"';
+  for(const char c : str)
+  {
+    if (c == '"')
+      out << "\\\"";
+    else if (c == '\\')
+      out << "\\\\";
+    else
+      out << c;
+  }
+  out << '"';
+}
+
+void write_atom(std::ostream& out, const sexp::Value& sx)
+{
+  switch(sx.get_type())
+  {
+    case sexp::Value::TYPE_NIL:
+      out << "()";
+      break;
+
+    case sexp::Value::TYPE_BOOLEAN:
+      out << (sx.as_bool() ? "#t" : "#f");
+      break;
+
+    case sexp::Value::TYPE_INTEGER:
+      out << sx.as_int();
+      break;
+
+    case sexp::Value::TYPE_REAL:
+    {
+      std::ostringstream str;
+      str.precision(std::numeric_limits<float>::max_digits10);
+      str << sx.as_float();
+      // keep "1.0" a real, "1" would be read back as integer
+      if (str.str().find_first_of(".e") == std::string::npos)
+        str << ".0";
+      out << str.str();
+      break;
+    }
+
+    case sexp::Value::TYPE_STRING:
+      write_escaped_string(out, sx.as_string());
+      break;
+
+    case sexp::Value::TYPE_SYMBOL:
+      out << sx.as_string();
+      break;
+
+    default:
+      throw std::runtime_error("value can't be written as text");
+  }
+}
+
+/** True for (_ "text"), which Writer keeps on the line of its key */
+bool is_translatable_string(const sexp::Value& sx)
+{
+  if (!sx.is_array())
+    return false;
+
+  auto const& arr = sx.as_array();
+  return arr.size() == 2 &&
+    arr[0].is_symbol() && arr[0].as_string() == "_" &&
+    arr[1].is_string();
+}
+
+void write_inline(std::ostream& out, const sexp::Value& sx)
+{
+  if (!sx.is_array())
+  {
+    write_atom(out, sx);
+    return;
+  }
+
+  out << '(';
+  auto const& arr = sx.as_array();
+  for(size_t i = 0; i < arr.size(); ++i)
+  {
+    if (i != 0)
+      out << ' ';
+    write_inline(out, arr[i]);
+  }
+  out << ')';
+}
+
+/** Writes lists of plain values on one line and everything else in
+    the indented layout of Writer */
+void write_value(std::ostream& out, const ReaderDocument& doc,
+                 const sexp::Value& sx, int indent)
+{
+  if (!sx.is_array())
+  {
+    write_atom(out, sx);
+    return;
+  }
+
+  auto const& arr = sx.as_array();
+  auto const values = doc.get_int_array(sx);
+  if (values && arr[0].is_symbol())
+  {
+    out << '(' << arr[0].as_string();
+    for(const auto& value : *values)
+      out << ' ' << value;
+    out << ')';
+    return;
+  }
+
+  // leading plain values stay on the line of the opening parenthesis
+  size_t i = 0;
+  while (i < arr.size() && (!arr[i].is_array() || is_translatable_string(arr[i])))
+    i += 1;
+
+  if (i == arr.size())
+  {
+    write_inline(out, sx);
+    return;
+  }
+
+  out << '(';
+  for(size_t j = 0; j < i; ++j)
+  {
+    if (j != 0)
+      out << ' ';
+    write_inline(out, arr[j]);
+  }
+
+  for(; i < arr.size(); ++i)
+  {
+    out << '\n' << std::string(indent + 2, ' ');
+    write_value(out, doc, arr[i], indent + 2);
+  }
+  out << '\n' << std::string(indent, ' ') << ')';
+}
+
+} // namespace
+
+namespace BinaryDocument {
+
+bool
+is_binary(const std::string& data)
+{
+  return data.size() >= sizeof(MAGIC) && memcmp(data.data(), MAGIC, sizeof(MAGIC)) == 0;
+}
+
+ReaderDocument
+read(const std::string& data, const std::string& filename)
+{
+  Decoder decoder(data, filename);
+  return decoder.decode();
+}
+
+void
+write(const ReaderDocument& doc, std::ostream& out)
+{
+  Encoder encoder(doc);
+  encoder.encode(doc.get_sexp());
+  encoder.finish(out);
+}
+
+void
+write_text(const ReaderDocument& doc, std::ostream& out)
+{
+  write_value(out, doc, doc.get_sexp(), 0);
+  out << '\n';
+}
+
+void
+convert(const std::string& input_filename, const std::string& output_filename)
+{
+  std::ifstream in(input_filename.c_str(), std::ios::binary);
+  if (!in)
+    throw std::runtime_error("Couldn't open '" + input_filename + "' for reading");
+
+  std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  bool binary = is_binary(data);
+
+  std::istringstream text(binary ? std::string() : data);
+  ReaderDocument doc = binary ? read(data, input_filename) : ReaderDocument::parse_level(text, input_filename);
+  data.clear();
+
+  std::ofstream out(output_filename.c_str(), std::ios::binary);
+  if (!out)
+    throw std::runtime_error("Couldn't open '" + output_filename + "' for writing");
+
+  if (binary)
+    write_text(doc, out);
+  else
+    write(doc, out);
+
+  out.close();
+  if (!out)
+    throw std::runtime_error("Couldn't write '" + output_filename + "'");
+
+  log_info << "Converted '" << input_filename << "' to " << (binary ? "text" : "binary")
+           << " '" << output_filename << "'" << std::endl;
+}
+
+} // namespace BinaryDocument
+
+/* EOF */
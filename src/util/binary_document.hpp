@@ -0,0 +1,57 @@
+//  SuperTux
+//  Copyright (C) 2018 SuperTux Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef HEADER_SUPERTUX_UTIL_BINARY_DOCUMENT_HPP
+#define HEADER_SUPERTUX_UTIL_BINARY_DOCUMENT_HPP
+
+#include <ostream>
+#include <string>
+
+class ReaderDocument;
+
+/**
+ * Versioned binary form of a ReaderDocument, used for levels. Symbols
+ * and strings are stored once in a string table and referenced by
+ * index, numbers are stored as little-endian 32 bit values. Integer
+ * lists like (tiles ...) are stored as raw uint32 arrays, run-length
+ * encoded when that is smaller. ReaderDocument::parse() recognizes
+ * the format by its magic, so binary files can be used everywhere a
+ * text file is accepted.
+ */
+namespace BinaryDocument {
+
+/** Returns true if data starts with the magic of the binary format */
+bool is_binary(const std::string& data);
+
+/** Decodes a binary document, throws std::runtime_error on damaged data */
+ReaderDocument read(const std::string& data, const std::string& filename);
+
+/** Writes doc in the binary format */
+void write(const ReaderDocument& doc, std::ostream& out);
+
+/** Writes doc as S-Expression text that parses back into the same document */
+void write_text(const ReaderDocument& doc, std::ostream& out);
+
+/** Converts a text file to the binary format and a binary file back
+    to text, filenames are regular paths, not PhysFS ones */
+void convert(const std::string& input_filename, const std::string& output_filename);
+
+} // namespace BinaryDocument
+
+#endif
+
+/* EOF */
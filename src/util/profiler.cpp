@@ -0,0 +1,217 @@
+//  SuperTux
+//  Copyright (C) 2018 SuperTux Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "util/profiler.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string.h>
+
+#include "util/log.hpp"
+
+namespace {
+
+// number of frames the displayed statistics are averaged over
+const int WINDOW_FRAMES = 64;
+
+} // namespace
+
+Profiler::Profiler() :
+  m_epoch(Clock::now()),
+  m_stack(),
+  m_stats(),
+  m_entries(),
+  m_window_frames(0),
+  m_total_frames(0),
+  m_trace(),
+  m_trace_empty(true)
+{
+}
+
+Profiler::~Profiler()
+{
+  if (m_trace)
+  {
+    *m_trace << "\n]}\n";
+  }
+}
+
+void
+Profiler::open_trace(const std::string& filename)
+{
+  m_trace.reset(new std::ofstream(filename.c_str()));
+  if (!*m_trace)
+  {
+    m_trace.reset();
+    throw std::runtime_error("Couldn't open trace file '" + filename + "'");
+  }
+
+  *m_trace << "{\"traceEvents\":[\n";
+  m_trace_empty = true;
+  log_info << "Writing profiler trace to '" << filename << "'" << std::endl;
+}
+
+void
+Profiler::begin_frame()
+{
+  begin_scope("frame");
+}
+
+void
+Profiler::end_frame()
+{
+  // close scopes left open by an exception
+  while (m_stack.size() > 1)
+    end_scope();
+  end_scope();
+
+  for(auto& stat : m_stats)
+  {
+    stat.window_time += stat.frame_time;
+    stat.peak = std::max(stat.peak, stat.frame_time);
+    stat.total_time += stat.frame_time;
+    stat.total_peak = std::max(stat.total_peak, stat.frame_time);
+    stat.frame_time = 0.0;
+  }
+
+  m_total_frames += 1;
+  m_window_frames += 1;
+  if (m_window_frames < WINDOW_FRAMES)
+    return;
+
+  m_entries.clear();
+  for(auto& stat : m_stats)
+  {
+    Entry entry;
+    entry.name = stat.name;
+    entry.depth = stat.depth;
+    entry.average = static_cast<float>(stat.window_time / m_window_frames);
+    entry.peak = static_cast<float>(stat.peak);
+    m_entries.push_back(entry);
+
+    stat.window_time = 0.0;
+    stat.peak = 0.0;
+  }
+  m_window_frames = 0;
+}
+
+std::vector<Profiler::Entry>
+Profiler::get_totals() const
+{
+  std::vector<Entry> totals;
+  if (m_total_frames == 0)
+    return totals;
+
+  for(const auto& stat : m_stats)
+  {
+    Entry entry;
+    entry.name = stat.name;
+    entry.depth = stat.depth;
+    entry.average = static_cast<float>(stat.total_time / m_total_frames);
+    entry.peak = static_cast<float>(stat.total_peak);
+    totals.push_back(entry);
+  }
+  return totals;
+}
+
+void
+Profiler::begin_scope(const char* name)
+{
+  int parent = m_stack.empty() ? -1 : m_stack.back().stat;
+
+  Scope scope;
+  scope.stat = find_stat(name, parent);
+  scope.start = Clock::now();
+  m_stack.push_back(scope);
+}
+
+void
+Profiler::end_scope()
+{
+  if (m_stack.empty())
+    return;
+
+  Clock::time_point now = Clock::now();
+  const Scope& scope = m_stack.back();
+  Stat& stat = m_stats[scope.stat];
+
+  stat.frame_time += std::chrono::duration<double, std::milli>(now - scope.start).count();
+
+  if (m_trace)
+  {
+    using std::chrono::microseconds;
+    using std::chrono::duration_cast;
+
+    if (!m_trace_empty)
+      *m_trace << ",\n";
+    *m_trace << "{\"name\":\"" << stat.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":1"
+             << ",\"ts\":" << duration_cast<microseconds>(scope.start - m_epoch).count()
+             << ",\"dur\":" << duration_cast<microseconds>(now - scope.start).count()
+             << "}";
+    m_trace_empty = false;
+  }
+
+  m_stack.pop_back();
+}
+
+int
+Profiler::find_stat(const char* name, int parent)
+{
+  for(size_t i = 0; i < m_stats.size(); ++i)
+  {
+    if (m_stats[i].parent == parent && strcmp(m_stats[i].name, name) == 0)
+      return static_cast<int>(i);
+  }
+
+  Stat stat;
+  stat.name = name;
+  stat.depth = (parent < 0) ? 0 : m_stats[parent].depth + 1;
+  stat.parent = parent;
+  stat.frame_time = 0.0;
+  stat.window_time = 0.0;
+  stat.peak = 0.0;
+  stat.total_time = 0.0;
+  stat.total_peak = 0.0;
+
+  // keep children right after their parent so the list reads like a tree
+  auto it = m_stats.end();
+  if (parent >= 0)
+  {
+    size_t pos = static_cast<size_t>(parent) + 1;
+    while (pos < m_stats.size() && m_stats[pos].depth > m_stats[parent].depth)
+      ++pos;
+    it = m_stats.begin() + pos;
+  }
+  int index = static_cast<int>(it - m_stats.begin());
+
+  // inserting shifts the indices behind it, fix up the references
+  for(auto& other : m_stats)
+  {
+    if (other.parent >= index)
+      other.parent += 1;
+  }
+  for(auto& scope : m_stack)
+  {
+    if (scope.stat >= index)
+      scope.stat += 1;
+  }
+
+  m_stats.insert(it, stat);
+  return index;
+}
+
+/* EOF */
@@ -0,0 +1,135 @@
+//  SuperTux
+//  Copyright (C) 2018 SuperTux Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef HEADER_SUPERTUX_UTIL_PROFILER_HPP
+#define HEADER_SUPERTUX_UTIL_PROFILER_HPP
+
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "util/currenton.hpp"
+
+/**
+ * Hierarchical frame profiler. Scopes are entered with ProfileScope,
+ * their times are summed up per frame and averaged over a window of
+ * frames for display. Optionally every scope is also written to a
+ * trace file that can be loaded into chrome://tracing.
+ */
+class Profiler final : public Currenton<Profiler>
+{
+public:
+  /** Timing of one scope, in milliseconds per frame */
+  struct Entry
+  {
+    const char* name;
+    int depth;
+    float average;
+    float peak;
+  };
+
+public:
+  Profiler();
+  ~Profiler();
+
+  /** Writes all following scopes to filename in the Chrome trace event format */
+  void open_trace(const std::string& filename);
+
+  void begin_frame();
+  void end_frame();
+
+  void begin_scope(const char* name);
+  void end_scope();
+
+  /** Statistics of the last completed window of frames, in the order
+      the scopes were first entered */
+  const std::vector<Entry>& get_entries() const { return m_entries; }
+
+  /** Statistics of all frames since the Profiler was created */
+  std::vector<Entry> get_totals() const;
+
+  int get_total_frames() const { return m_total_frames; }
+
+private:
+  typedef std::chrono::steady_clock Clock;
+
+  struct Scope
+  {
+    int stat;
+    Clock::time_point start;
+  };
+
+  struct Stat
+  {
+    const char* name;
+    int depth;
+    int parent;
+    double frame_time;
+    double window_time;
+    double peak;
+    double total_time;
+    double total_peak;
+  };
+
+  int find_stat(const char* name, int parent);
+
+private:
+  Clock::time_point m_epoch;
+  std::vector<Scope> m_stack;
+  std::vector<Stat> m_stats;
+  std::vector<Entry> m_entries;
+  int m_window_frames;
+  int m_total_frames;
+
+  std::unique_ptr<std::ofstream> m_trace;
+  bool m_trace_empty;
+
+private:
+  Profiler(const Profiler&) = delete;
+  Profiler& operator=(const Profiler&) = delete;
+};
+
+/** Profiles the enclosing block, does nothing if there is no Profiler */
+class ProfileScope final
+{
+public:
+  ProfileScope(const char* name) :
+    m_profiler(Profiler::current())
+  {
+    if (m_profiler)
+      m_profiler->begin_scope(name);
+  }
+
+  ~ProfileScope()
+  {
+    if (m_profiler)
+      m_profiler->end_scope();
+  }
+
+private:
+  Profiler* m_profiler;
+
+private:
+  ProfileScope(const ProfileScope&) = delete;
+  ProfileScope& operator=(const ProfileScope&) = delete;
+};
+
+#endif
+
+/* EOF */
@@ -16,21 +16,210 @@
 
 #include "util/reader_document.hpp"
 
+#include <ctype.h>
+#include <iterator>
+#include <limits>
 #include <sexp/parser.hpp>
 #include <sstream>
+#include <string.h>
 
 #include "physfs/ifile_streambuf.hpp"
+#include "util/binary_document.hpp"
 #include "util/log.hpp"
 
+namespace {
+
+/** keys whose integer lists are decoded by pack_int_arrays() */
+const char* const PACKED_KEYS[] = { "tiles" };
+
+/** mappings with fewer items are searched linearly */
+const size_t MIN_INDEXED_SIZE = 8;
+
+/** symbol of the list that takes the place of a packed list */
+const char* const PACKED_ARRAY_SYMBOL = "packed-int-array";
+
+bool is_space(char c)
+{
+  return isspace(static_cast<unsigned char>(c)) != 0;
+}
+
+/** Decodes the integers of a list up to its closing ')', pos points
+    right behind the key of the list. Gives up on anything but plain
+    non-negative numbers that fit into an int, those are left to the
+    sexp parser so that it reports errors and handles comments. */
+bool decode_int_list(const std::string& text, size_t& pos,
+                     std::vector<uint32_t>& values, int& newlines)
+{
+  const uint32_t max_value = static_cast<uint32_t>(std::numeric_limits<int>::max());
+
+  values.clear();
+  newlines = 0;
+
+  size_t i = pos;
+  while (i < text.size())
+  {
+    char c = text[i];
+    if (c == ')')
+    {
+      pos = i + 1;
+      return true;
+    }
+    else if (is_space(c))
+    {
+      if (c == '\n')
+        newlines += 1;
+      i += 1;
+    }
+    else if (c >= '0' && c <= '9')
+    {
+      uint32_t value = 0;
+      do
+      {
+        uint32_t digit = static_cast<uint32_t>(text[i] - '0');
+        if (value > (max_value - digit) / 10)
+          return false;
+        value = value * 10 + digit;
+        i += 1;
+      }
+      while (i < text.size() && text[i] >= '0' && text[i] <= '9');
+
+      // "1.5", "12abc" or "1(" are not for us
+      if (i < text.size() && text[i] != ')' && !is_space(text[i]))
+        return false;
+
+      values.push_back(value);
+    }
+    else
+    {
+      return false;
+    }
+  }
+  return false;
+}
+
+/** Replaces every (key 1 2 3 ...) with a PACKED_KEYS key by
+    (key (packed-int-array N)), with N being an index into int_arrays.
+    Strings and comments are skipped the same way the sexp parser does,
+    and the newlines of a replaced list are kept, so line numbers in
+    error messages stay correct. Returns false if nothing was packed. */
+bool pack_int_arrays(const std::string& text, std::string& out,
+                     std::vector<std::vector<uint32_t> >& int_arrays)
+{
+  std::vector<uint32_t> values;
+  size_t copied = 0;
+
+  size_t i = 0;
+  while (i < text.size())
+  {
+    char c = text[i];
+    if (c == '"')
+    {
+      i += 1;
+      while (i < text.size() && text[i] != '"')
+        i += (text[i] == '\\') ? 2 : 1;
+      i += 1;
+    }
+    else if (c == ';')
+    {
+      while (i < text.size() && text[i] != '\n')
+        i += 1;
+    }
+    else if (c == '(')
+    {
+      i += 1;
+      while (i < text.size() && (text[i] == ' ' || text[i] == '\t'))
+        i += 1;
+
+      for(const char* key : PACKED_KEYS)
+      {
+        size_t len = strlen(key);
+        size_t end = i + len;
+        if (end >= text.size() ||
+            text.compare(i, len, key) != 0 ||
+            !(is_space(text[end]) || text[end] == ')'))
+          continue;
+
+        size_t pos = end;
+        int newlines;
+        if (!decode_int_list(text, pos, values, newlines))
+          break;
+
+        std::ostringstream placeholder;
+        placeholder << " (" << PACKED_ARRAY_SYMBOL << " " << int_arrays.size() << "))";
+
+        out.append(text, copied, end - copied);
+        out += placeholder.str();
+        out.append(static_cast<size_t>(newlines), '\n');
+        copied = pos;
+        i = pos;
+
+        int_arrays.push_back(std::move(values));
+        break;
+      }
+    }
+    else
+    {
+      i += 1;
+    }
+  }
+
+  if (int_arrays.empty())
+    return false;
+
+  if (copied < text.size())
+    out.append(text, copied, std::string::npos);
+  return true;
+}
+
+} // namespace
+
 ReaderDocument
 ReaderDocument::parse(std::istream& stream, const std::string& filename)
 {
-  sexp::Value sx = sexp::Parser::from_stream(stream, sexp::Parser::USE_ARRAYS);
-  return ReaderDocument(filename, std::move(sx));
+  return parse(stream, filename, false);
 }
 
 ReaderDocument
 ReaderDocument::parse(const std::string& filename)
+{
+  return parse(filename, false);
+}
+
+ReaderDocument
+ReaderDocument::parse_level(std::istream& stream, const std::string& filename)
+{
+  return parse(stream, filename, true);
+}
+
+ReaderDocument
+ReaderDocument::parse_level(const std::string& filename)
+{
+  return parse(filename, true);
+}
+
+ReaderDocument
+ReaderDocument::parse(std::istream& stream, const std::string& filename,
+                      bool pack)
+{
+  std::string text((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+
+  if (BinaryDocument::is_binary(text))
+    return BinaryDocument::read(text, filename);
+
+  std::string packed_text;
+  std::vector<std::vector<uint32_t> > int_arrays;
+  if (pack && pack_int_arrays(text, packed_text, int_arrays))
+  {
+    text = std::move(packed_text);
+  }
+
+  std::istringstream in(text);
+  sexp::Value sx = sexp::Parser::from_stream(in, sexp::Parser::USE_ARRAYS);
+  return ReaderDocument(filename, std::move(sx), std::move(int_arrays));
+}
+
+ReaderDocument
+ReaderDocument::parse(const std::string& filename, bool pack)
 {
   log_debug << "ReaderDocument::parse: " << filename << std::endl;
 
@@ -42,19 +231,24 @@ ReaderDocument::parse(const std::string& filename)
     msg << "Parser problem: Couldn't open file '" << filename << "'.";
     throw std::runtime_error(msg.str());
   } else {
-    return parse(in, filename);
+    return parse(in, filename, pack);
   }
 }
 
 ReaderDocument::ReaderDocument() :
   m_filename(),
-  m_sx()
+  m_sx(),
+  m_int_arrays(),
+  m_index_cache()
 {
 }
 
-ReaderDocument::ReaderDocument(const std::string& filename, sexp::Value sx) :
+ReaderDocument::ReaderDocument(const std::string& filename, sexp::Value sx,
+                               std::vector<std::vector<uint32_t> > int_arrays) :
   m_filename(filename),
-  m_sx(std::move(sx))
+  m_sx(std::move(sx)),
+  m_int_arrays(std::move(int_arrays)),
+  m_index_cache()
 {
 }
 
@@ -70,4 +264,70 @@ ReaderDocument::get_filename() const
   return m_filename;
 }
 
+const std::vector<uint32_t>*
+ReaderDocument::get_int_array(const sexp::Value& sx) const
+{
+  if (!sx.is_array() || sx.as_array().size() != 2)
+    return nullptr;
+
+  auto const& ref = sx.as_array()[1];
+  if (!ref.is_array() || ref.as_array().size() != 2)
+    return nullptr;
+
+  auto const& arr = ref.as_array();
+  if (!arr[0].is_symbol() || arr[0].as_string() != PACKED_ARRAY_SYMBOL || !arr[1].is_integer())
+    return nullptr;
+
+  int index = arr[1].as_int();
+  if (index < 0 || static_cast<size_t>(index) >= m_int_arrays.size())
+    return nullptr;
+
+  return &m_int_arrays[index];
+}
+
+const ReaderDocument::Index*
+ReaderDocument::get_index(const sexp::Value& sx) const
+{
+  if (!sx.is_array() || sx.as_array().size() < MIN_INDEXED_SIZE)
+    return nullptr;
+
+  auto it = m_index_cache.indices.find(&sx);
+  if (it != m_index_cache.indices.end())
+    return it->second.get();
+
+  auto const& arr = sx.as_array();
+  std::unique_ptr<Index> index(new Index);
+  index->reserve(arr.size());
+  for(size_t i = 1; i < arr.size(); ++i)
+  {
+    auto const& item = arr[i];
+    if (!item.is_array() || item.as_array().empty() || !item.as_array()[0].is_symbol())
+    {
+      // leave the error reporting to the linear search
+      index.reset();
+      break;
+    }
+
+    // like the linear search, the first of duplicate keys wins
+    index->emplace(item.as_array()[0].as_string(), &item);
+  }
+
+  const Index* result = index.get();
+  m_index_cache.indices[&sx] = std::move(index);
+  return result;
+}
+
+sexp::Value
+ReaderDocument::make_int_array_ref(const std::string& key, size_t index)
+{
+  std::vector<sexp::Value> ref;
+  ref.push_back(sexp::Value::symbol(PACKED_ARRAY_SYMBOL));
+  ref.push_back(sexp::Value::integer(static_cast<int>(index)));
+
+  std::vector<sexp::Value> item;
+  item.push_back(sexp::Value::symbol(key));
+  item.push_back(sexp::Value::array(std::move(ref)));
+  return sexp::Value::array(std::move(item));
+}
+
 /* EOF */
@@ -18,27 +18,78 @@
 #define HEADER_SUPERTUX_UTIL_READER_DOCUMENT_HPP
 
 #include <istream>
+#include <memory>
 #include <sexp/value.hpp>
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
 
 #include "util/reader_object.hpp"
 
 /** The ReaderDocument holds the memory */
 class ReaderDocument final
 {
+public:
+  typedef std::unordered_map<std::string, const sexp::Value*> Index;
+
 public:
   static ReaderDocument parse(std::istream& stream, const std::string& filename = "<stream>");
   static ReaderDocument parse(const std::string& filename);
 
+  /** Like parse(), but for levels and worldmaps: the (tiles 1 2 3 ...)
+      lists of their tilemaps are decoded into int arrays, see
+      get_int_array(). Other documents are left alone, as a (tiles ...)
+      list means something else there. */
+  static ReaderDocument parse_level(std::istream& stream, const std::string& filename = "<stream>");
+  static ReaderDocument parse_level(const std::string& filename);
+
 public:
   ReaderDocument();
-  ReaderDocument(const std::string& filename, sexp::Value sx);
+  ReaderDocument(const std::string& filename, sexp::Value sx,
+                 std::vector<std::vector<uint32_t> > int_arrays = {});
 
   ReaderObject get_root() const;
   std::string get_filename() const;
+  const sexp::Value& get_sexp() const { return m_sx; }
+
+  /** Integer lists like (tiles 1 2 3 ...) are decoded directly
+      by parse_level() instead of becoming one sexp::Value per number, the
+      list is replaced with a reference into the document. Returns the
+      numbers if sx is such a (key ...) list, nullptr otherwise. */
+  const std::vector<uint32_t>* get_int_array(const sexp::Value& sx) const;
+
+  /** Creates the (key ...) list that refers to int_arrays[index] of
+      the document it ends up in, for readers of other formats */
+  static sexp::Value make_int_array_ref(const std::string& key, size_t index);
+
+  /** Returns a key -> (key value) index of the mapping sx, built on
+      first use. Returns nullptr for mappings that are too small for
+      an index to pay off or that contain malformed items, those have
+      to be searched linearly. */
+  const Index* get_index(const sexp::Value& sx) const;
+
+private:
+  static ReaderDocument parse(std::istream& stream, const std::string& filename,
+                              bool pack_int_arrays);
+  static ReaderDocument parse(const std::string& filename, bool pack_int_arrays);
+
+  /** Cache for get_index(), a copied document starts with an empty
+      one as the keys point into the original */
+  class IndexCache
+  {
+  public:
+    IndexCache() : indices() {}
+    IndexCache(const IndexCache&) : indices() {}
+    IndexCache& operator=(const IndexCache&) { indices.clear(); return *this; }
+
+    std::unordered_map<const sexp::Value*, std::unique_ptr<Index> > indices;
+  };
 
 private:
   std::string m_filename;
   sexp::Value m_sx;
+  std::vector<std::vector<uint32_t> > m_int_arrays;
+  mutable IndexCache m_index_cache;
 };
 
 #endif
@@ -63,6 +63,13 @@ ReaderMapping::get_item(const char* key) const
 {
   assert(m_arr);
 
+  auto const index = m_doc->get_index(*m_sx);
+  if (index)
+  {
+    auto it = index->find(key);
+    return (it == index->end()) ? nullptr : it->second;
+  }
+
   for(size_t i = 1; i < m_arr->size(); ++i)
   {
     auto const& pair = (*m_arr)[i];
@@ -81,6 +88,22 @@ ReaderMapping::get_item(const char* key) const
   return nullptr;
 }
 
+template<typename T>
+bool
+ReaderMapping::get_int_array(const char* key, std::vector<T>& value) const
+{
+  auto const sx = get_item(key);
+  if (!sx)
+    return false;
+
+  auto const values = m_doc->get_int_array(*sx);
+  if (!values)
+    return false;
+
+  value.assign(values->begin(), values->end());
+  return true;
+}
+
 #define GET_VALUE_MACRO(type, checker, getter)                          \
   auto const sx = get_item(key);                                        \
   if (!sx) {                                                            \
@@ -230,6 +253,8 @@ bool
 ReaderMapping::get(const char* key, std::vector<int>& value) const
 {
   value.clear();
+  if (get_int_array(key, value))
+    return true;
   GET_VALUES_MACRO("int", is_integer, as_int);
 }
 
@@ -252,6 +277,8 @@ bool
 ReaderMapping::get(const char* key, std::vector<unsigned int>& value) const
 {
   value.clear();
+  if (get_int_array(key, value))
+    return true;
   GET_VALUES_MACRO("unsigned int", is_integer, as_int);
 }
 
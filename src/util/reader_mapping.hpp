@@ -65,6 +65,10 @@ private:
   /** Returns pointer to (key value) */
   const sexp::Value* get_item(const char* key) const;
 
+  /** Fills value if key is a list decoded by ReaderDocument::parse() */
+  template<typename T>
+  bool get_int_array(const char* key, std::vector<T>& value) const;
+
 private:
   const ReaderDocument* m_doc;
   const sexp::Value* m_sx;
@@ -21,6 +21,7 @@
 #include "supertux/globals.hpp"
 #include "util/log.hpp"
 #include "util/obstackpp.hpp"
+#include "util/profiler.hpp"
 #include "video/drawing_request.hpp"
 #include "video/lightmap.hpp"
 #include "video/painter.hpp"
@@ -39,13 +40,33 @@ DrawingEffect effect_from_surface(const Surface& surface)
   }
 }
 
+/** Checks if the TextureRequest rhs can be drawn in one batch with lhs,
+    which is the case for draws from the same atlas page */
+bool can_merge(const DrawingRequest& lhs, const DrawingRequest& rhs)
+{
+  if (rhs.type != TEXTURE)
+    return false;
+
+  const auto& lhs_data = static_cast<const TextureRequest&>(lhs);
+  const auto& rhs_data = static_cast<const TextureRequest&>(rhs);
+
+  return lhs_data.texture == rhs_data.texture &&
+    lhs.angle == 0.0f && rhs.angle == 0.0f &&
+    lhs.drawing_effect == rhs.drawing_effect &&
+    lhs.alpha == rhs.alpha &&
+    lhs.blend.sfactor == rhs.blend.sfactor &&
+    lhs.blend.dfactor == rhs.blend.dfactor &&
+    lhs_data.color == rhs_data.color;
+}
+
 } // namespace
 
 Canvas::Canvas(DrawingTarget target, DrawingContext& context, obstack& obst) :
   m_target(target),
   m_context(context),
   m_obst(obst),
-  m_requests()
+  m_requests(),
+  m_sorter()
 {
 }
 
@@ -67,12 +88,11 @@ Canvas::clear()
 void
 Canvas::render(VideoSystem& video_system, Filter filter)
 {
-  // On a regular level, each frame has around 1000-3000 requests, the
-  // sort comparator function is called approximatly 7 times for each request.
-  std::stable_sort(m_requests.begin(), m_requests.end(),
-                   [](const DrawingRequest* r1, const DrawingRequest* r2){
-                     return r1->layer < r2->layer;
-                   });
+  ProfileScope scope("Canvas::render");
+
+  // On a regular level, each frame has around 1000-3000 requests,
+  // spread over a few dozen layers.
+  m_sorter.sort(m_requests);
 
   Renderer& renderer = video_system.get_renderer();
   Lightmap& lightmap = video_system.get_lightmap();
@@ -81,23 +101,69 @@ Canvas::render(VideoSystem& video_system, Filter filter)
     lightmap.get_painter() :
     renderer.get_painter();
 
-  for(const auto& i : m_requests) {
-    const DrawingRequest& request = *i;
+  auto is_filtered = [filter](const DrawingRequest& request) {
+    return ((filter == BELOW_LIGHTMAP && request.layer >= LAYER_LIGHTMAP) ||
+            (filter == ABOVE_LIGHTMAP && request.layer <= LAYER_LIGHTMAP));
+  };
 
-    if (filter == BELOW_LIGHTMAP && request.layer >= LAYER_LIGHTMAP)
-      continue;
-    else if (filter == ABOVE_LIGHTMAP && request.layer <= LAYER_LIGHTMAP)
+  // reused for merging runs of TextureRequests
+  TextureBatchRequest batch;
+
+  for(size_t i = 0; i < m_requests.size(); ++i) {
+    const DrawingRequest& request = *m_requests[i];
+
+    if (is_filtered(request))
       continue;
 
     switch(request.type) {
       case TEXTURE:
-        painter.draw_texture(request);
+        {
+          size_t end = i + 1;
+          while (end < m_requests.size() &&
+                 !is_filtered(*m_requests[end]) &&
+                 can_merge(request, *m_requests[end]))
+          {
+            ++end;
+          }
+
+          if (end - i == 1)
+          {
+            painter.draw_texture(request);
+          }
+          else
+          {
+            const auto& data = static_cast<const TextureRequest&>(request);
+
+            batch.layer = request.layer;
+            batch.drawing_effect = request.drawing_effect;
+            batch.alpha = request.alpha;
+            batch.blend = request.blend;
+            batch.texture = data.texture;
+            batch.color = data.color;
+            batch.srcrects.clear();
+            batch.dstrects.clear();
+            batch.angles.clear();
+            for(size_t j = i; j < end; ++j)
+            {
+              const auto& part = static_cast<const TextureRequest&>(*m_requests[j]);
+              batch.srcrects.push_back(part.srcrect);
+              batch.dstrects.push_back(part.dstrect);
+            }
+
+            painter.draw_texture_batch(batch);
+            i = end - 1;
+          }
+        }
         break;
 
       case TEXTURE_BATCH:
         painter.draw_texture_batch(request);
         break;
 
+      case VERTEX_BUFFER:
+        painter.draw_vertex_buffer(request);
+        break;
+
       case GRADIENT:
         painter.draw_gradient(request);
         break;
@@ -135,14 +201,12 @@ Canvas::render(VideoSystem& video_system, Filter filter)
 }
 
 void
-Canvas::draw_surface(SurfacePtr surface, const Vector& position,
+Canvas::draw_surface(const SurfacePtr& surface, const Vector& position,
                      float angle, const Color& color, const Blend& blend,
-                     int layer)
+                     int layer, DrawingEffect effect)
 {
   assert(surface != 0);
 
-  auto request = new(m_obst) TextureRequest();
-
   const auto& cliprect = m_context.get_cliprect();
 
   // discard clipped surface
@@ -152,14 +216,16 @@ Canvas::draw_surface(SurfacePtr surface, const Vector& position,
      position.y + static_cast<float>(surface->get_height()) < cliprect.get_top())
     return;
 
+  auto request = new(m_obst) TextureRequest();
+
   request->type = TEXTURE;
   request->layer = layer;
-  request->drawing_effect = m_context.transform().drawing_effect ^ effect_from_surface(*surface);
+  request->drawing_effect = m_context.transform().drawing_effect ^ effect ^ effect_from_surface(*surface);
   request->alpha = m_context.transform().alpha;
   request->angle = angle;
   request->blend = blend;
 
-  request->srcrect = Rectf(0, 0, static_cast<float>(surface->get_width()), static_cast<float>(surface->get_height()));
+  request->srcrect = Rectf(surface->get_position(), Size(surface->get_width(), surface->get_height()));
   request->dstrect = Rectf(apply_translate(position), Size(surface->get_width(), surface->get_height()));
   request->texture = surface->get_texture().get();
   request->color = color;
@@ -168,7 +234,7 @@ Canvas::draw_surface(SurfacePtr surface, const Vector& position,
 }
 
 void
-Canvas::draw_surface(SurfacePtr surface, const Vector& position, int layer)
+Canvas::draw_surface(const SurfacePtr& surface, const Vector& position, int layer)
 {
   draw_surface(surface, position, 0.0f, Color(1.0f, 1.0f, 1.0f), Blend(), layer);
 }
@@ -187,7 +253,8 @@ Canvas::draw_surface_part(SurfacePtr surface,
   request->drawing_effect = m_context.transform().drawing_effect ^ effect_from_surface(*surface);
   request->alpha = m_context.transform().alpha;
 
-  request->srcrect = srcrect;
+  // srcrect is relative to the surface, which may be part of an atlas page
+  request->srcrect = Rectf(srcrect.p1 + surface->get_position(), srcrect.get_size());
   request->dstrect = Rectf(apply_translate(dstrect.p1), dstrect.get_size());
   request->texture = surface->get_texture().get();
 
@@ -200,8 +267,20 @@ Canvas::draw_surface_batch(SurfacePtr surface,
                            const std::vector<Rectf>& dstrects,
                            const Color& color,
                            int layer)
+{
+  draw_surface_batch(surface, srcrects, dstrects, std::vector<float>(), color, layer);
+}
+
+void
+Canvas::draw_surface_batch(SurfacePtr surface,
+                           const std::vector<Rectf>& srcrects,
+                           const std::vector<Rectf>& dstrects,
+                           const std::vector<float>& angles,
+                           const Color& color,
+                           int layer)
 {
   assert(surface != 0);
+  assert(angles.empty() || angles.size() == dstrects.size());
 
   auto request = new(m_obst) TextureBatchRequest();
 
@@ -212,13 +291,39 @@ Canvas::draw_surface_batch(SurfacePtr surface,
   request->color = color;
 
   request->srcrects = srcrects;
+  for(auto& srcrect : request->srcrects)
+  {
+    srcrect = Rectf(srcrect.p1 + surface->get_position(), srcrect.get_size());
+  }
+
   request->dstrects = dstrects;
   for(auto& dstrect : request->dstrects)
   {
     dstrect = Rectf(apply_translate(dstrect.p1), dstrect.get_size());
   }
 
+  request->angles = angles;
+  request->texture = surface->get_texture().get();
+
+  m_requests.push_back(request);
+}
+
+void
+Canvas::draw_vertex_buffer(SurfacePtr surface, const VertexBuffer& buffer,
+                           const Vector& position, const Color& color,
+                           int layer)
+{
+  assert(surface != 0);
+
+  auto request = new(m_obst) VertexBufferRequest();
+
+  request->layer = layer;
+  request->alpha = m_context.transform().alpha;
+  request->color = color;
+
+  request->pos = apply_translate(position);
   request->texture = surface->get_texture().get();
+  request->buffer = &buffer;
 
   m_requests.push_back(request);
 }
@@ -25,11 +25,14 @@
 #include "math/rectf.hpp"
 #include "math/vector.hpp"
 #include "video/color.hpp"
+#include "video/drawing_effect.hpp"
 #include "video/font.hpp"
 #include "video/font_ptr.hpp"
 #include "video/drawing_target.hpp"
+#include "video/layer_sorter.hpp"
 
 struct DrawingRequest;
+class VertexBuffer;
 class VideoSystem;
 class DrawingContext;
 
@@ -88,11 +91,13 @@ public:
   Canvas(DrawingTarget target, DrawingContext& context, obstack& obst);
   ~Canvas();
 
-  void draw_surface(SurfacePtr surface, const Vector& position,
+  void draw_surface(const SurfacePtr& surface, const Vector& position,
                     int layer);
-  void draw_surface(SurfacePtr surface, const Vector& position,
+  /** effect is combined with the drawing effect of the current
+      transform, so callers don't have to push a transform for it */
+  void draw_surface(const SurfacePtr& surface, const Vector& position,
                     float angle, const Color& color, const Blend& blend,
-                    int layer);
+                    int layer, DrawingEffect effect = NO_EFFECT);
   void draw_surface_part(SurfacePtr surface,
                          const Rectf& srcrect, const Rectf& dstrect,
                          int layer);
@@ -101,6 +106,20 @@ public:
                           const std::vector<Rectf>& dstrects,
                           const Color& color,
                           int layer);
+  /** Like the above, but rotates each dstrect around its center by
+      the matching entry in angles */
+  void draw_surface_batch(SurfacePtr surface,
+                          const std::vector<Rectf>& srcrects,
+                          const std::vector<Rectf>& dstrects,
+                          const std::vector<float>& angles,
+                          const Color& color,
+                          int layer);
+  /** Draws a buffer filled with quads of surface's texture. The drawing
+      effect of the current transform is not applied, it has to be baked
+      into the buffer. */
+  void draw_vertex_buffer(SurfacePtr surface, const VertexBuffer& buffer,
+                          const Vector& position, const Color& color,
+                          int layer);
   void draw_text(FontPtr font, const std::string& text,
                  const Vector& position, FontAlignment alignment, int layer, const Color& color = Color(1.0,1.0,1.0));
   /** Draw text to the center of the screen */
@@ -133,6 +152,7 @@ private:
   DrawingContext& m_context;
   obstack& m_obst;
   std::vector<DrawingRequest*> m_requests;
+  LayerSorter m_sorter;
 
 private:
   Canvas(const Canvas&) = delete;
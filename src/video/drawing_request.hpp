@@ -27,10 +27,11 @@
 #include "video/font.hpp"
 
 class Surface;
+class VertexBuffer;
 
 enum RequestType
 {
-  TEXTURE, TEXTURE_BATCH, TEXT, GRADIENT, FILLRECT, INVERSEELLIPSE, GETLIGHT, LINE, TRIANGLE
+  TEXTURE, TEXTURE_BATCH, VERTEX_BUFFER, TEXT, GRADIENT, FILLRECT, INVERSEELLIPSE, GETLIGHT, LINE, TRIANGLE
 };
 
 struct DrawingRequest
@@ -78,16 +79,19 @@ private:
 struct TextureBatchRequest : public DrawingRequest
 {
   TextureBatchRequest() :
-    DrawingRequest(TEXTURE),
+    DrawingRequest(TEXTURE_BATCH),
     texture(),
     srcrects(),
     dstrects(),
+    angles(),
     color(1.0f, 1.0f, 1.0f)
   {}
 
   const Texture* texture;
   std::vector<Rectf> srcrects;
   std::vector<Rectf> dstrects;
+  /** rotation of each quad in degrees, empty when none is rotated */
+  std::vector<float> angles;
   Color color;
 
 private:
@@ -95,6 +99,26 @@ private:
   TextureBatchRequest& operator=(const TextureBatchRequest&) = delete;
 };
 
+struct VertexBufferRequest : public DrawingRequest
+{
+  VertexBufferRequest() :
+    DrawingRequest(VERTEX_BUFFER),
+    texture(),
+    buffer(),
+    pos(),
+    color(1.0f, 1.0f, 1.0f)
+  {}
+
+  const Texture* texture;
+  const VertexBuffer* buffer;
+  Vector pos;
+  Color color;
+
+private:
+  VertexBufferRequest(const VertexBufferRequest&) = delete;
+  VertexBufferRequest& operator=(const VertexBufferRequest&) = delete;
+};
+
 struct TextRequest : public DrawingRequest
 {
   TextRequest() :
@@ -49,6 +49,10 @@ bool vline_empty(SDL_Surface* surface, int x, int start_y, int end_y, Uint8 thre
   return true;
 }
 
+// texts like timers change every frame, the cache of an alignment is
+// dropped when it grows beyond this
+const size_t MAX_CACHED_LAYOUTS = 256;
+
 } // namespace
 
 Font::Font(GlyphWidth glyph_width_,
@@ -61,10 +65,10 @@ Font::Font(GlyphWidth glyph_width_,
   shadowsize(shadowsize_),
   border(0),
   rtl(false),
-  glyphs(65536)
+  glyphs(),
+  layouts(),
+  batch(new TextureBatchRequest)
 {
-  for(unsigned int i=0; i<65536;i++) glyphs[i].surface_idx = -1;
-
   const std::string fontdir = FileSystem::dirname(filename);
   const std::string fontname = FileSystem::basename(filename);
 
@@ -83,6 +87,9 @@ Font::Font(GlyphWidth glyph_width_,
     }
   }
   PHYSFS_freeList(rc);
+
+  log_debug << "Font " << filename << ": " << glyphs.get_sparse_count() << " glyphs above U+00FF, "
+            << glyphs.get_memory_usage() / 1024 << " KiB glyph table" << std::endl;
 }
 
 void
@@ -202,7 +209,7 @@ Font::loadFontSurface(
       int y = row * (char_height + 2*border) + border;
       int x = col * (char_width + 2*border) + border;
       if( ++col == wrap ) { col=0; row++; }
-      if( *chr == 0x0020 && glyphs[0x20].surface_idx != -1) continue;
+      if( *chr == 0x0020 && glyphs.get(0x20).surface_idx != -1) continue;
 
       Glyph glyph;
       glyph.surface_idx   = surface_idx;
@@ -248,7 +255,7 @@ Font::loadFontSurface(
                            static_cast<float>(y + char_height));
       }
 
-      glyphs[*chr] = glyph;
+      glyphs.set(*chr, glyph);
     }
     if( col>0 && col <= wrap ) {
       col = 0;
@@ -267,6 +274,22 @@ Font::~Font()
 {
 }
 
+const Font::Glyph&
+Font::get_glyph(uint32_t chr) const
+{
+  const Glyph& glyph = glyphs.get(chr);
+  if( glyph.surface_idx != -1 )
+    return glyph;
+  else
+    return glyphs.get(0x20);
+}
+
+float
+Font::get_advance(uint32_t chr) const
+{
+  return get_glyph(chr).advance;
+}
+
 float
 Font::get_text_width(const std::string& text) const
 {
@@ -282,10 +305,7 @@ Font::get_text_width(const std::string& text) const
     }
     else
     {
-      if( glyphs.at(*it).surface_idx != -1 )
-        curr_width += glyphs[*it].advance;
-      else
-        curr_width += glyphs[0x20].advance;
+      curr_width += get_advance(*it);
     }
   }
 
@@ -347,14 +367,36 @@ Font::wrap_to_width(const std::string& s_, float width, std::string* overflow)
     return s;
   }
 
-  // if we can find a whitespace character to break at, return text up to this character
-  for (int i = static_cast<int>(s.length()) - 1; i >= 0; i--) {
-    std::string s2 = s.substr(0,i);
-    if (s[i] != ' ') continue;
-    if (get_text_width(s2) <= width) {
-      if (overflow) *overflow = s.substr(i+1);
-      return s.substr(0, i);
+  // if we can find a whitespace character to break at, return text up
+  // to this character. The width of a prefix never shrinks as it gets
+  // longer, so the last whitespace that still fits is found in one pass.
+  std::string::size_type break_pos = std::string::npos;
+  float curr_width = 0;
+  float last_width = 0;
+  for(UTF8Iterator it(s); !it.done(); ++it)
+  {
+    if (*it == ' ')
+    {
+      if (std::max(curr_width, last_width) > width)
+        break;
+      // the iterator is already past the character
+      break_pos = it.pos - 1;
+    }
+
+    if (*it == '\n')
+    {
+      last_width = std::max(last_width, curr_width);
+      curr_width = 0;
     }
+    else
+    {
+      curr_width += get_advance(*it);
+    }
+  }
+
+  if (break_pos != std::string::npos) {
+    if (overflow) *overflow = s.substr(break_pos+1);
+    return s.substr(0, break_pos);
   }
 
   // FIXME: hard-wrap at width, taking care of multibyte characters
@@ -363,98 +405,119 @@ Font::wrap_to_width(const std::string& s_, float width, std::string* overflow)
 }
 
 void
-Font::draw(Painter& painter, const std::string& text, const Vector& pos_,
+Font::draw(Painter& painter, const std::string& text, const Vector& pos,
            FontAlignment alignment, DrawingEffect drawing_effect, Color color,
            float alpha) const
 {
-  float x = pos_.x;
-  float y = pos_.y;
+  const TextLayout& layout = get_layout(text, alignment);
+
+  batch->drawing_effect = drawing_effect;
+  batch->alpha = alpha;
+
+  if(shadowsize > 0)
+    draw_layout(painter, layout, shadow_surfaces,
+                pos + Vector(static_cast<float>(shadowsize), static_cast<float>(shadowsize)), Color(1,1,1));
+
+  draw_layout(painter, layout, glyph_surfaces, pos, color);
+}
+
+const Font::TextLayout&
+Font::get_layout(const std::string& text, FontAlignment alignment) const
+{
+  auto& cache = layouts[alignment];
+  auto cached = cache.find(text);
+  if (cached != cache.end())
+    return cached->second;
 
+  if (cache.size() >= MAX_CACHED_LAYOUTS)
+    cache.clear();
+
+  TextLayout& layout = cache[text];
+  std::vector<int> surface_runs(glyph_surfaces.size(), -1);
+
+  float y = 0;
+  int line = 0;
   std::string::size_type last = 0;
   for(std::string::size_type i = 0;; ++i)
   {
-    if (text[i] == '\n' || i == text.size())
+    if (i == text.size() || text[i] == '\n')
     {
       std::string temp = text.substr(last, i - last);
 
       // calculate X positions based on the alignment type
-      Vector pos = Vector(x, y);
-
       if(alignment == ALIGN_CENTER)
-        pos.x -= get_text_width(temp) / 2;
+        layout.line_offsets.push_back(-get_text_width(temp) / 2);
       else if(alignment == ALIGN_RIGHT)
-        pos.x -= get_text_width(temp);
+        layout.line_offsets.push_back(-get_text_width(temp));
+      else
+        layout.line_offsets.push_back(0.0f);
 
-      // Cast font position to integer to get a clean drawing result and
-      // no blurring as we would get with subpixel positions
-      pos.x = std::truncf(pos.x);
+      if (rtl)
+        std::reverse(temp.begin(), temp.end());
 
-      draw_text(painter, temp, pos, drawing_effect, color, alpha);
+      float x = 0;
+      for(UTF8Iterator it(temp); !it.done(); ++it)
+      {
+        const Glyph& glyph = get_glyph(*it);
+        if (*it != ' ' && glyph.surface_idx != -1)
+        {
+          int& run_idx = surface_runs[glyph.surface_idx];
+          if (run_idx == -1)
+          {
+            run_idx = static_cast<int>(layout.runs.size());
+            layout.runs.push_back(TextLayout::Run());
+            layout.runs.back().surface_idx = glyph.surface_idx;
+          }
+
+          TextLayout::Run& run = layout.runs[run_idx];
+          run.srcrects.push_back(glyph.rect);
+          run.dstrects.push_back(Rectf(Vector(x, y) + glyph.offset, glyph.rect.get_size()));
+          run.lines.push_back(line);
+        }
+        x += glyph.advance;
+      }
 
       if (i == text.size())
         break;
 
       y += static_cast<float>(char_height) + 2.0f;
+      line += 1;
       last = i + 1;
     }
   }
-}
 
-void
-Font::draw_text(Painter& painter, const std::string& text, const Vector& pos,
-                DrawingEffect drawing_effect, Color color, float alpha) const
-{
-  if(shadowsize > 0)
-    draw_chars(painter, false, rtl ? std::string(text.rbegin(), text.rend()) : text,
-               pos + Vector(static_cast<float>(shadowsize), static_cast<float>(shadowsize)), drawing_effect, Color(1,1,1), alpha);
-
-  draw_chars(painter, true, rtl ? std::string(text.rbegin(), text.rend()) : text, pos, drawing_effect, color, alpha);
+  return layout;
 }
 
 void
-Font::draw_chars(Painter& painter, bool notshadow, const std::string& text,
-                 const Vector& pos, DrawingEffect drawing_effect, Color color,
-                 float alpha) const
+Font::draw_layout(Painter& painter, const TextLayout& layout,
+                  const std::vector<SurfacePtr>& surfaces,
+                  const Vector& pos, const Color& color) const
 {
-  Vector p = pos;
-
-  for(UTF8Iterator it(text); !it.done(); ++it)
+  // Cast the line positions to integer to get a clean drawing result and
+  // no blurring as we would get with subpixel positions
+  std::vector<float> line_x;
+  line_x.reserve(layout.line_offsets.size());
+  for(const auto& offset : layout.line_offsets)
+    line_x.push_back(std::truncf(pos.x + offset));
+
+  for(const auto& run : layout.runs)
   {
-    if(*it == '\n')
-    {
-      p.x = pos.x;
-      p.y += static_cast<float>(char_height) + 2.0f;
-    }
-    else if(*it == ' ')
+    const SurfacePtr& surface = surfaces[run.surface_idx];
+
+    batch->texture = surface->get_texture().get();
+    batch->color = color;
+    batch->srcrects.clear();
+    batch->dstrects.clear();
+    for(size_t i = 0; i < run.srcrects.size(); ++i)
     {
-      p.x += glyphs[0x20].advance;
+      const Rectf& src = run.srcrects[i];
+      const Rectf& dst = run.dstrects[i];
+      batch->srcrects.push_back(Rectf(src.p1 + surface->get_position(), src.get_size()));
+      batch->dstrects.push_back(Rectf(Vector(line_x[run.lines[i]], pos.y) + dst.p1, dst.get_size()));
     }
-    else
-    {
-      Glyph glyph;
-      if( glyphs.at(*it).surface_idx != -1 )
-        glyph = glyphs[*it];
-      else
-        glyph = glyphs[0x20];
-
-      // FIXME: this could all be handled in Canvas, no need for Font
-      // to mess around with low level code
-      TextureRequest request;
-
-      request.drawing_effect = drawing_effect;
-      request.alpha = alpha;
 
-      request.color = color;
-      request.srcrect = glyph.rect;
-      request.dstrect = Rectf(p + glyph.offset, glyph.rect.get_size());
-      request.texture = notshadow ?
-        glyph_surfaces[glyph.surface_idx]->get_texture().get() :
-        shadow_surfaces[glyph.surface_idx]->get_texture().get();
-
-      painter.draw_texture(request);
-
-      p.x += glyph.advance;
-    }
+    painter.draw_texture_batch(*batch);
   }
 }
 
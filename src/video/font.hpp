@@ -18,15 +18,21 @@
 #ifndef HEADER_SUPERTUX_VIDEO_FONT_HPP
 #define HEADER_SUPERTUX_VIDEO_FONT_HPP
 
+#include <memory>
+#include <stdint.h>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "math/rectf.hpp"
 #include "math/vector.hpp"
 #include "video/color.hpp"
+#include "video/glyph_table.hpp"
 #include "video/surface_ptr.hpp"
 #include "video/texture.hpp"
 
 class Painter;
+struct TextureBatchRequest;
 
 enum FontAlignment {
   ALIGN_LEFT,
@@ -81,7 +87,8 @@ public:
   std::string wrap_to_width(const std::string& text, float width, std::string* overflow);
 
   /** Draws the given text to the screen. Also needs the position.
-   * Type of alignment, drawing effect and alpha are optional. */
+   * Type of alignment, drawing effect and alpha are optional.
+   * The glyphs are drawn with one batch per glyph surface. */
   void draw(Painter& painter, const std::string& text, const Vector& pos,
             FontAlignment alignment = ALIGN_LEFT,
             DrawingEffect drawing_effect = NO_EFFECT,
@@ -91,14 +98,36 @@ public:
 private:
   friend class DrawingContext;
 
-  void draw_text(Painter& painter, const std::string& text, const Vector& pos,
-                 DrawingEffect drawing_effect = NO_EFFECT,
-                 Color color = Color(1.0,1.0,1.0),
-                 float alpha = 1.0f) const;
+  /** Glyph quads of a text relative to the position it is drawn at,
+      grouped by the glyph surface they are on */
+  struct TextLayout
+  {
+    struct Run
+    {
+      Run() : surface_idx(), srcrects(), dstrects(), lines() {}
+
+      int surface_idx;
+      std::vector<Rectf> srcrects;
+      std::vector<Rectf> dstrects;
+      /** line of each quad, to look up its offset */
+      std::vector<int> lines;
+    };
+
+    TextLayout() : line_offsets(), runs() {}
+
+    /** horizontal offset of each line caused by the alignment */
+    std::vector<float> line_offsets;
+    std::vector<Run> runs;
+  };
+
+  /** returns the cached layout of the text, creating it if needed */
+  const TextLayout& get_layout(const std::string& text, FontAlignment alignment) const;
+
+  void draw_layout(Painter& painter, const TextLayout& layout,
+                   const std::vector<SurfacePtr>& surfaces,
+                   const Vector& pos, const Color& color) const;
 
-  void draw_chars(Painter& painter, bool nonshadow, const std::string& text,
-                  const Vector& position, DrawingEffect drawing_effect, Color color,
-                  float alpha) const;
+  float get_advance(uint32_t chr) const;
 
   void loadFontFile(const std::string &filename);
   void loadFontSurface(const std::string &glyphimage,
@@ -124,11 +153,14 @@ private:
     Glyph() :
       advance(),
       offset(),
-      surface_idx(),
+      surface_idx(-1),
       rect()
     {}
   };
 
+  /** returns the glyph of the character, the one of space if there is none */
+  const Glyph& get_glyph(uint32_t chr) const;
+
 private:
   GlyphWidth glyph_width;
 
@@ -139,8 +171,13 @@ private:
   int border;
   bool rtl;
 
-  /** 65536 of glyphs */
-  std::vector<Glyph> glyphs;
+  GlyphTable<Glyph> glyphs;
+
+  /** layouts of the recently drawn texts, one map per FontAlignment */
+  mutable std::unordered_map<std::string, TextLayout> layouts[3];
+
+  /** reused for drawing the runs of a layout */
+  std::unique_ptr<TextureBatchRequest> batch;
 };
 
 #endif
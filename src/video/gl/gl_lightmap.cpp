@@ -17,13 +17,19 @@
 #include "video/gl/gl_lightmap.hpp"
 
 #include <iostream>
+#include <string.h>
 
+#ifdef USE_GLBINDING
+  #include <glbinding/ContextInfo.h>
+#endif
+
+#include "math/util.hpp"
 #include "supertux/globals.hpp"
 #include "video/drawing_request.hpp"
-#include "video/gl/gl_painter.hpp"
 #include "video/gl/gl_texture.hpp"
 #include "video/gl/gl_video_system.hpp"
 #include "video/glutil.hpp"
+#include "video/painter.hpp"
 
 inline int next_po2(int val)
 {
@@ -34,18 +40,44 @@ inline int next_po2(int val)
   return result;
 }
 
+namespace {
+
+bool has_pixel_buffer_objects()
+{
+#ifdef GL_VERSION_ES_CM_1_0
+  return false;
+#elif defined(USE_GLBINDING)
+  static auto extensions = glbinding::ContextInfo::extensions();
+  return extensions.find(GLextension::GL_ARB_pixel_buffer_object) != extensions.end();
+#else
+  return GLEW_ARB_pixel_buffer_object || GLEW_VERSION_2_1;
+#endif
+}
+
+} // namespace
+
 GLLightmap::GLLightmap(GLVideoSystem& video_system, const Size& size) :
   m_video_system(video_system),
   m_size(size),
-  m_painter(m_video_system),
+  m_painter(m_video_system.create_painter()),
   m_lightmap(),
   m_lightmap_width(),
-  m_lightmap_height()
+  m_lightmap_height(),
+  m_pixel_buffer(),
+  m_readback_pending(false),
+  m_readback_requested(false),
+  m_pixels()
 {
 }
 
 GLLightmap::~GLLightmap()
 {
+#ifndef GL_VERSION_ES_CM_1_0
+  if (m_pixel_buffer)
+  {
+    glDeleteBuffers(1, &m_pixel_buffer);
+  }
+#endif
 }
 
 void
@@ -58,8 +90,22 @@ GLLightmap::start_draw()
 
     m_lightmap.reset(new GLTexture(next_po2(m_lightmap_width),
                                    next_po2(m_lightmap_height)));
+
+#ifndef GL_VERSION_ES_CM_1_0
+    if (has_pixel_buffer_objects())
+    {
+      glGenBuffers(1, &m_pixel_buffer);
+      glBindBuffer(GL_PIXEL_PACK_BUFFER, m_pixel_buffer);
+      glBufferData(GL_PIXEL_PACK_BUFFER, m_lightmap_width * m_lightmap_height * 4,
+                   NULL, GL_STREAM_READ);
+      glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    }
+#endif
   }
 
+  // the readback started last frame had a whole frame to finish
+  finish_readback();
+
   glViewport(0, 0, m_lightmap_width, m_lightmap_height);
 
   glMatrixMode(GL_PROJECTION);
@@ -78,6 +124,8 @@ GLLightmap::start_draw()
 void
 GLLightmap::end_draw()
 {
+  m_painter->flush();
+
   glBindTexture(GL_TEXTURE_2D, m_lightmap->get_handle());
   glCopyTexSubImage2D(GL_TEXTURE_2D,
                       0, // level
@@ -85,11 +133,71 @@ GLLightmap::end_draw()
                       0, 0, // x, y
                       m_lightmap_width,
                       m_lightmap_height);
+
+  // only levels that query the light pay for the readback
+  if (m_readback_requested)
+  {
+    m_readback_requested = false;
+    start_readback();
+  }
+  else
+  {
+    // would be stale by the time get_light() is used again
+    m_pixels.clear();
+  }
+}
+
+void
+GLLightmap::start_readback()
+{
+  glPixelStorei(GL_PACK_ALIGNMENT, 4);
+
+#ifndef GL_VERSION_ES_CM_1_0
+  if (m_pixel_buffer)
+  {
+    // returns immediately, the copy happens in the background
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, m_pixel_buffer);
+    glReadPixels(0, 0, m_lightmap_width, m_lightmap_height,
+                 GL_RGBA, GL_UNSIGNED_BYTE, 0);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    m_readback_pending = true;
+    return;
+  }
+#endif
+
+  // without pixel buffer objects, at least read the whole lightmap
+  // once instead of stalling for every single request
+  m_pixels.resize(m_lightmap_width * m_lightmap_height * 4);
+  glReadPixels(0, 0, m_lightmap_width, m_lightmap_height,
+               GL_RGBA, GL_UNSIGNED_BYTE, m_pixels.data());
+}
+
+void
+GLLightmap::finish_readback()
+{
+#ifndef GL_VERSION_ES_CM_1_0
+  if (!m_readback_pending)
+    return;
+
+  m_readback_pending = false;
+
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, m_pixel_buffer);
+  const void* data = glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+  if (data)
+  {
+    m_pixels.resize(m_lightmap_width * m_lightmap_height * 4);
+    memcpy(m_pixels.data(), data, m_pixels.size());
+    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+  }
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+#endif
 }
 
 void
 GLLightmap::render()
 {
+  m_painter->flush();
+
   // multiple the lightmap with the framebuffer
   glBlendFunc(GL_DST_COLOR, GL_ZERO);
 
@@ -121,6 +229,7 @@ GLLightmap::render()
 void
 GLLightmap::clear(const Color& color)
 {
+  m_painter->flush();
   glClearColor(color.red, color.green, color.blue, color.alpha);
   glClear(GL_COLOR_BUFFER_BIT);
 }
@@ -128,6 +237,8 @@ GLLightmap::clear(const Color& color)
 void
 GLLightmap::set_clip_rect(const Rect& clip_rect)
 {
+  m_painter->flush();
+
   glScissor(m_lightmap_width * clip_rect.left / m_size.width,
             m_lightmap_height * clip_rect.top / m_size.height,
             m_lightmap_width * clip_rect.get_width() / m_size.width,
@@ -138,6 +249,7 @@ GLLightmap::set_clip_rect(const Rect& clip_rect)
 void
 GLLightmap::clear_clip_rect()
 {
+  m_painter->flush();
   glDisable(GL_SCISSOR_TEST);
 }
 
@@ -146,16 +258,33 @@ GLLightmap::get_light(const DrawingRequest& request) const
 {
   const auto& data = static_cast<const GetLightRequest&>(request);
 
-  float pixels[3] = { 0.0f, 0.0f, 0.0f };
+  m_readback_requested = true;
 
   float x = data.pos.x * static_cast<float>(m_lightmap_width) / static_cast<float>(m_size.width);
   float y = data.pos.y * static_cast<float>(m_lightmap_height) / static_cast<float>(m_size.height);
 
-  glReadPixels(static_cast<GLint>(x),
-               m_lightmap_height - static_cast<GLint>(y),
-               1, 1, GL_RGB, GL_FLOAT, pixels);
+  if (m_pixels.empty())
+  {
+    m_painter->flush();
+
+    // nothing read back in the last frame, happens on the first frame
+    // with light queries
+    float pixels[3] = { 0.0f, 0.0f, 0.0f };
+    glReadPixels(static_cast<GLint>(x),
+                 m_lightmap_height - static_cast<GLint>(y),
+                 1, 1, GL_RGB, GL_FLOAT, pixels);
+
+    *(data.color_ptr) = Color(pixels[0], pixels[1], pixels[2]);
+    return;
+  }
+
+  int px = math::clamp(static_cast<int>(x), 0, m_lightmap_width - 1);
+  int py = math::clamp(m_lightmap_height - static_cast<int>(y), 0, m_lightmap_height - 1);
+  const GLubyte* pixel = &m_pixels[(py * m_lightmap_width + px) * 4];
 
-  *(data.color_ptr) = Color(pixels[0], pixels[1], pixels[2]);
+  *(data.color_ptr) = Color(static_cast<float>(pixel[0]) / 255.0f,
+                            static_cast<float>(pixel[1]) / 255.0f,
+                            static_cast<float>(pixel[2]) / 255.0f);
 }
 
 /* EOF */
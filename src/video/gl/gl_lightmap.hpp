@@ -18,12 +18,14 @@
 #define HEADER_SUPERTUX_VIDEO_GL_LIGHTMAP_HPP
 
 #include <memory>
+#include <vector>
 
-#include "video/gl/gl_painter.hpp"
+#include "math/size.hpp"
 #include "video/glutil.hpp"
 #include "video/lightmap.hpp"
 
 class GLTexture;
+class Painter;
 class GLVideoSystem;
 class Rect;
 class Texture;
@@ -38,7 +40,7 @@ public:
   virtual void start_draw() override;
   virtual void end_draw() override;
 
-  virtual GLPainter& get_painter() override { return m_painter; }
+  virtual Painter& get_painter() override { return *m_painter; }
 
   virtual void clear(const Color& color) override;
 
@@ -51,15 +53,33 @@ public:
 private:
   static const int s_LIGHTMAP_DIV = 5;
 
+  /** Starts copying the lightmap into m_pixels, asynchronously if
+      pixel buffer objects are available */
+  void start_readback();
+
+  /** Moves the result of the last start_readback() into m_pixels */
+  void finish_readback();
+
 private:
   GLVideoSystem& m_video_system;
   Size m_size;
-  GLPainter m_painter;
+  std::unique_ptr<Painter> m_painter;
 
   std::shared_ptr<GLTexture> m_lightmap;
   int m_lightmap_width;
   int m_lightmap_height;
 
+  /** pixel buffer object the lightmap is read back into, 0 if unsupported */
+  GLuint m_pixel_buffer;
+  bool m_readback_pending;
+
+  /** set by get_light(), the lightmap is only read back in frames
+      where it is set */
+  mutable bool m_readback_requested;
+
+  /** RGBA copy of the previous frame's lightmap, used by get_light() */
+  std::vector<GLubyte> m_pixels;
+
 private:
   GLLightmap(const GLLightmap&);
   GLLightmap& operator=(const GLLightmap&);
@@ -23,6 +23,7 @@
 #include "supertux/globals.hpp"
 #include "video/drawing_request.hpp"
 #include "video/gl/gl_texture.hpp"
+#include "video/gl/gl_vertex_buffer.hpp"
 #include "video/gl/gl_video_system.hpp"
 #include "video/video_system.hpp"
 #include "video/viewport.hpp"
@@ -177,17 +178,45 @@ GLPainter::draw_texture_batch(const DrawingRequest& request)
     if (request.drawing_effect & VERTICAL_FLIP)
       std::swap(uv_top, uv_bottom);
 
-    auto vertices_lst = {
-      left, top,
-      right, top,
-      right, bottom,
+    if (data.angles.empty() || data.angles[i] == 0.0f)
+    {
+      auto vertices_lst = {
+        left, top,
+        right, top,
+        right, bottom,
 
-      left, bottom,
-      left, top,
-      right, bottom,
-    };
+        left, bottom,
+        left, top,
+        right, bottom,
+      };
+
+      vertices.insert(vertices.end(), std::begin(vertices_lst), std::end(vertices_lst));
+    }
+    else
+    {
+      const float center_x = (left + right) / 2;
+      const float center_y = (top + bottom) / 2;
+
+      const float sa = sinf(math::radians(data.angles[i]));
+      const float ca = cosf(math::radians(data.angles[i]));
+
+      const float l = left - center_x;
+      const float r = right - center_x;
+      const float t = top - center_y;
+      const float b = bottom - center_y;
+
+      auto vertices_lst = {
+        l*ca - t*sa + center_x, l*sa + t*ca + center_y,
+        r*ca - t*sa + center_x, r*sa + t*ca + center_y,
+        r*ca - b*sa + center_x, r*sa + b*ca + center_y,
+
+        l*ca - b*sa + center_x, l*sa + b*ca + center_y,
+        l*ca - t*sa + center_x, l*sa + t*ca + center_y,
+        r*ca - b*sa + center_x, r*sa + b*ca + center_y,
+      };
 
-    vertices.insert(vertices.end(), std::begin(vertices_lst), std::end(vertices_lst));
+      vertices.insert(vertices.end(), std::begin(vertices_lst), std::end(vertices_lst));
+    }
 
     auto uvs_lst = {
       uv_left, uv_top,
@@ -215,6 +244,43 @@ GLPainter::draw_texture_batch(const DrawingRequest& request)
   glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 }
 
+void
+GLPainter::draw_vertex_buffer(const DrawingRequest& request)
+{
+  const auto& data = static_cast<const VertexBufferRequest&>(request);
+  const auto& texture = static_cast<const GLTexture&>(*data.texture);
+  const auto& buffer = static_cast<const GLVertexBuffer&>(*data.buffer);
+
+  if (buffer.get_quad_count() == 0)
+    return;
+
+  GLuint handle = texture.get_handle();
+  if (handle != s_last_texture)
+  {
+    s_last_texture = handle;
+    glBindTexture(GL_TEXTURE_2D, handle);
+  }
+
+  glBlendFunc(request.blend.sfactor, request.blend.dfactor);
+  glColor4f(data.color.red, data.color.green, data.color.blue, data.color.alpha * request.alpha);
+
+  glPushMatrix();
+  glTranslatef(data.pos.x, data.pos.y, 0);
+
+  const GLsizei stride = 4 * sizeof(float);
+  glBindBuffer(GL_ARRAY_BUFFER, buffer.get_handle());
+  glVertexPointer(2, GL_FLOAT, stride, reinterpret_cast<void*>(0));
+  glTexCoordPointer(2, GL_FLOAT, stride, reinterpret_cast<void*>(2 * sizeof(float)));
+
+  glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(buffer.get_quad_count() * 2 * 3));
+
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  glPopMatrix();
+
+  glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+  glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+}
+
 void
 GLPainter::draw_gradient(const DrawingRequest& request)
 {
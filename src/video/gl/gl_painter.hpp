@@ -44,6 +44,7 @@ public:
 
   void draw_texture(const DrawingRequest& request);
   void draw_texture_batch(const DrawingRequest& request);
+  void draw_vertex_buffer(const DrawingRequest& request);
   void draw_gradient(const DrawingRequest& request);
   void draw_filled_rect(const DrawingRequest& request);
   void draw_inverse_ellipse(const DrawingRequest& request);
@@ -23,10 +23,11 @@
 #include "util/log.hpp"
 #include "video/gl/gl_video_system.hpp"
 #include "video/glutil.hpp"
+#include "video/painter.hpp"
 
 GLRenderer::GLRenderer(GLVideoSystem& video_system) :
   m_video_system(video_system),
-  m_painter(m_video_system)
+  m_painter(m_video_system.create_painter())
 {
 }
 
@@ -73,11 +74,13 @@ GLRenderer::start_draw()
 void
 GLRenderer::end_draw()
 {
+  m_painter->flush();
 }
 
 void
 GLRenderer::clear(const Color& color)
 {
+  m_painter->flush();
   glClearColor(color.red, color.green, color.blue, color.alpha);
   glClear(GL_COLOR_BUFFER_BIT);
 }
@@ -85,6 +88,8 @@ GLRenderer::clear(const Color& color)
 void
 GLRenderer::set_clip_rect(const Rect& clip_rect)
 {
+  m_painter->flush();
+
   auto window_size = m_video_system.get_window_size();
 
   const Viewport& viewport = m_video_system.get_viewport();
@@ -99,6 +104,7 @@ GLRenderer::set_clip_rect(const Rect& clip_rect)
 void
 GLRenderer::clear_clip_rect()
 {
+  m_painter->flush();
   glDisable(GL_SCISSOR_TEST);
 }
 
@@ -18,9 +18,10 @@
 #define HEADER_SUPERTUX_VIDEO_GL_RENDERER_HPP
 
 #include <SDL.h>
+#include <memory>
 
 #include "math/vector.hpp"
-#include "video/gl/gl_painter.hpp"
+#include "video/painter.hpp"
 #include "video/renderer.hpp"
 
 class GLVideoSystem;
@@ -37,7 +38,7 @@ public:
   virtual void start_draw() override;
   virtual void end_draw() override;
 
-  virtual GLPainter& get_painter() override { return m_painter; }
+  virtual Painter& get_painter() override { return *m_painter; }
 
   virtual void clear(const Color& color) override;
 
@@ -46,7 +47,7 @@ public:
 
 private:
   GLVideoSystem& m_video_system;
-  GLPainter m_painter;
+  std::unique_ptr<Painter> m_painter;
 
 private:
   GLRenderer(const GLRenderer&) = delete;
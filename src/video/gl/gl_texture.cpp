@@ -186,6 +186,53 @@ GLTexture::~GLTexture()
   glDeleteTextures(1, &m_handle);
 }
 
+void
+GLTexture::update_region(SDL_Surface* image, int x, int y)
+{
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+  SDL_Surface* convert = SDL_CreateRGBSurface(0, image->w, image->h, 32,
+                                              0xff000000, 0x00ff0000, 0x0000ff00, 0x000000ff);
+#else
+  SDL_Surface* convert = SDL_CreateRGBSurface(0, image->w, image->h, 32,
+                                              0x000000ff, 0x0000ff00, 0x00ff0000, 0xff000000);
+#endif
+
+  if(convert == 0) {
+    throw std::runtime_error("Couldn't update texture: out of memory");
+  }
+
+  SDL_SetSurfaceBlendMode(image, SDL_BLENDMODE_NONE);
+  SDL_BlitSurface(image, 0, convert, 0);
+
+  // keep the binding of the painter intact
+  GLint last_texture;
+  glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture);
+
+  glBindTexture(GL_TEXTURE_2D, m_handle);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+#if defined(GL_UNPACK_ROW_LENGTH) || defined(USE_GLBINDING)
+  glPixelStorei(GL_UNPACK_ROW_LENGTH, convert->pitch/convert->format->BytesPerPixel);
+#endif
+
+  if(SDL_MUSTLOCK(convert))
+  {
+    SDL_LockSurface(convert);
+  }
+
+  glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, convert->w, convert->h,
+                  GL_RGBA, GL_UNSIGNED_BYTE, convert->pixels);
+
+  if(SDL_MUSTLOCK(convert))
+  {
+    SDL_UnlockSurface(convert);
+  }
+
+  glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(last_texture));
+  SDL_FreeSurface(convert);
+
+  assert_gl("updating texture");
+}
+
 void
 GLTexture::set_texture_params()
 {
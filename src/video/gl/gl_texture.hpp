@@ -74,6 +74,8 @@ public:
     m_image_height = height;
   }
 
+  void update_region(SDL_Surface* image, int x, int y) override;
+
 private:
   void set_texture_params();
 };
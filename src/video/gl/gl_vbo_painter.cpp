@@ -0,0 +1,587 @@
+//  SuperTux
+//  Copyright (C) 2018 SuperTux Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "video/gl/gl_vbo_painter.hpp"
+
+#include <algorithm>
+#include <assert.h>
+#include <math.h>
+#include <stddef.h>
+
+#include "math/util.hpp"
+#include "video/drawing_request.hpp"
+#include "video/gl/gl_texture.hpp"
+#include "video/gl/gl_vertex_buffer.hpp"
+#include "video/gl/gl_video_system.hpp"
+#include "video/viewport.hpp"
+
+namespace {
+
+// attribute locations, bound before linking
+const GLuint ATTRIB_POSITION = 0;
+const GLuint ATTRIB_TEXCOORD = 1;
+const GLuint ATTRIB_COLOR = 2;
+
+// initial size of the stream buffer, grows when a single batch doesn't fit
+const size_t STREAM_BUFFER_SIZE = 1024 * 1024;
+
+const char* s_vertex_shader =
+  "#version 120\n"
+  "uniform vec2 offset;\n"
+  "attribute vec2 position;\n"
+  "attribute vec2 texcoord;\n"
+  "attribute vec4 color;\n"
+  "varying vec2 v_texcoord;\n"
+  "varying vec4 v_color;\n"
+  "void main()\n"
+  "{\n"
+  "  v_texcoord = texcoord;\n"
+  "  v_color = color;\n"
+  "  gl_Position = gl_ModelViewProjectionMatrix * vec4(position + offset, 0.0, 1.0);\n"
+  "}\n";
+
+const char* s_fragment_shader =
+  "#version 120\n"
+  "uniform sampler2D diffuse;\n"
+  "varying vec2 v_texcoord;\n"
+  "varying vec4 v_color;\n"
+  "void main()\n"
+  "{\n"
+  "  gl_FragColor = texture2D(diffuse, v_texcoord) * v_color;\n"
+  "}\n";
+
+GLubyte to_ubyte(float value)
+{
+  return static_cast<GLubyte>(math::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+}
+
+GLuint compile_shader(GLenum type, const char* source)
+{
+  GLuint shader = glCreateShader(type);
+  glShaderSource(shader, 1, &source, nullptr);
+  glCompileShader(shader);
+
+  GLint status = 0;
+  glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+  if (!status)
+  {
+    GLint length = 0;
+    glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &length);
+    std::vector<char> info(std::max(length, 1));
+    glGetShaderInfoLog(shader, static_cast<GLsizei>(info.size()), nullptr, info.data());
+    glDeleteShader(shader);
+
+    std::ostringstream msg;
+    msg << "GLVBOPainter: shader compilation failed: " << info.data();
+    throw std::runtime_error(msg.str());
+  }
+
+  return shader;
+}
+
+} // namespace
+
+GLVBOPainter::GLVBOPainter(GLVideoSystem& video_system) :
+  m_video_system(video_system),
+  m_program(),
+  m_offset_location(-1),
+  m_texture_location(-1),
+  m_white_texture(),
+  m_stream_buffer(),
+  m_stream_capacity(STREAM_BUFFER_SIZE),
+  m_stream_offset(0),
+  m_vertices(),
+  m_texture(),
+  m_blend(),
+  m_mode(GL_TRIANGLES)
+{
+#if !defined(USE_GLBINDING) && !defined(GL_VERSION_ES_CM_1_0)
+  if (!GLEW_VERSION_2_0)
+  {
+    throw std::runtime_error("GLVBOPainter: OpenGL 2.0 is required");
+  }
+#endif
+
+  create_program();
+  create_white_texture();
+
+  glGenBuffers(1, &m_stream_buffer);
+  glBindBuffer(GL_ARRAY_BUFFER, m_stream_buffer);
+  glBufferData(GL_ARRAY_BUFFER, m_stream_capacity, nullptr, GL_STREAM_DRAW);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+  check_gl_error("GLVBOPainter setup");
+}
+
+GLVBOPainter::~GLVBOPainter()
+{
+  glDeleteBuffers(1, &m_stream_buffer);
+  glDeleteTextures(1, &m_white_texture);
+  glDeleteProgram(m_program);
+}
+
+void
+GLVBOPainter::create_program()
+{
+  GLuint vertex_shader = compile_shader(GL_VERTEX_SHADER, s_vertex_shader);
+  GLuint fragment_shader;
+  try
+  {
+    fragment_shader = compile_shader(GL_FRAGMENT_SHADER, s_fragment_shader);
+  }
+  catch(...)
+  {
+    glDeleteShader(vertex_shader);
+    throw;
+  }
+
+  m_program = glCreateProgram();
+  glAttachShader(m_program, vertex_shader);
+  glAttachShader(m_program, fragment_shader);
+  glBindAttribLocation(m_program, ATTRIB_POSITION, "position");
+  glBindAttribLocation(m_program, ATTRIB_TEXCOORD, "texcoord");
+  glBindAttribLocation(m_program, ATTRIB_COLOR, "color");
+  glLinkProgram(m_program);
+
+  // the program keeps the shaders alive as long as it needs them
+  glDeleteShader(vertex_shader);
+  glDeleteShader(fragment_shader);
+
+  GLint status = 0;
+  glGetProgramiv(m_program, GL_LINK_STATUS, &status);
+  if (!status)
+  {
+    GLint length = 0;
+    glGetProgramiv(m_program, GL_INFO_LOG_LENGTH, &length);
+    std::vector<char> info(std::max(length, 1));
+    glGetProgramInfoLog(m_program, static_cast<GLsizei>(info.size()), nullptr, info.data());
+    glDeleteProgram(m_program);
+
+    std::ostringstream msg;
+    msg << "GLVBOPainter: program linking failed: " << info.data();
+    throw std::runtime_error(msg.str());
+  }
+
+  m_offset_location = glGetUniformLocation(m_program, "offset");
+  m_texture_location = glGetUniformLocation(m_program, "diffuse");
+}
+
+void
+GLVBOPainter::create_white_texture()
+{
+  const GLubyte white[4] = { 255, 255, 255, 255 };
+
+  glGenTextures(1, &m_white_texture);
+  glBindTexture(GL_TEXTURE_2D, m_white_texture);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, white);
+  glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void
+GLVBOPainter::begin(GLuint texture, const Blend& blend, GLenum mode)
+{
+  if (!m_vertices.empty() &&
+      (texture != m_texture ||
+       blend.sfactor != m_blend.sfactor ||
+       blend.dfactor != m_blend.dfactor ||
+       mode != m_mode))
+  {
+    flush();
+  }
+
+  m_texture = texture;
+  m_blend = blend;
+  m_mode = mode;
+}
+
+void
+GLVBOPainter::add_vertex(float x, float y, float u, float v, const Color& color)
+{
+  Vertex vertex;
+  vertex.x = x;
+  vertex.y = y;
+  vertex.u = u;
+  vertex.v = v;
+  vertex.color[0] = to_ubyte(color.red);
+  vertex.color[1] = to_ubyte(color.green);
+  vertex.color[2] = to_ubyte(color.blue);
+  vertex.color[3] = to_ubyte(color.alpha);
+  m_vertices.push_back(vertex);
+}
+
+void
+GLVBOPainter::add_quad(const Rectf& dstrect, float uv_left, float uv_top,
+                       float uv_right, float uv_bottom, float angle, const Color& color)
+{
+  float x[4] = { dstrect.p1.x, dstrect.p2.x, dstrect.p2.x, dstrect.p1.x };
+  float y[4] = { dstrect.p1.y, dstrect.p1.y, dstrect.p2.y, dstrect.p2.y };
+
+  if (angle != 0.0f)
+  {
+    const float center_x = (dstrect.p1.x + dstrect.p2.x) / 2;
+    const float center_y = (dstrect.p1.y + dstrect.p2.y) / 2;
+
+    const float sa = sinf(math::radians(angle));
+    const float ca = cosf(math::radians(angle));
+
+    for (int i = 0; i < 4; ++i)
+    {
+      const float dx = x[i] - center_x;
+      const float dy = y[i] - center_y;
+      x[i] = dx * ca - dy * sa + center_x;
+      y[i] = dx * sa + dy * ca + center_y;
+    }
+  }
+
+  add_vertex(x[0], y[0], uv_left, uv_top, color);
+  add_vertex(x[1], y[1], uv_right, uv_top, color);
+  add_vertex(x[2], y[2], uv_right, uv_bottom, color);
+
+  add_vertex(x[3], y[3], uv_left, uv_bottom, color);
+  add_vertex(x[0], y[0], uv_left, uv_top, color);
+  add_vertex(x[2], y[2], uv_right, uv_bottom, color);
+}
+
+size_t
+GLVBOPainter::upload()
+{
+  const size_t size = m_vertices.size() * sizeof(Vertex);
+
+  glBindBuffer(GL_ARRAY_BUFFER, m_stream_buffer);
+
+  if (m_stream_offset + size > m_stream_capacity)
+  {
+    // orphan the buffer instead of waiting for draws still using it
+    while (size > m_stream_capacity)
+      m_stream_capacity *= 2;
+
+    glBufferData(GL_ARRAY_BUFFER, m_stream_capacity, nullptr, GL_STREAM_DRAW);
+    m_stream_offset = 0;
+  }
+
+  const size_t offset = m_stream_offset;
+  glBufferSubData(GL_ARRAY_BUFFER, offset, size, m_vertices.data());
+  m_stream_offset += size;
+
+  return offset;
+}
+
+void
+GLVBOPainter::bind_program(const Vector& offset)
+{
+  glUseProgram(m_program);
+  glUniform2f(m_offset_location, offset.x, offset.y);
+  glUniform1i(m_texture_location, 0);
+}
+
+void
+GLVBOPainter::unbind_program()
+{
+  glDisableVertexAttribArray(ATTRIB_POSITION);
+  glDisableVertexAttribArray(ATTRIB_TEXCOORD);
+  glDisableVertexAttribArray(ATTRIB_COLOR);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  glUseProgram(0);
+
+  // the fixed function code expects the default blend mode
+  glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+}
+
+void
+GLVBOPainter::flush()
+{
+  if (m_vertices.empty())
+    return;
+
+  const size_t offset = upload();
+
+  bind_program(Vector(0.0f, 0.0f));
+  glBindTexture(GL_TEXTURE_2D, m_texture);
+  glBlendFunc(m_blend.sfactor, m_blend.dfactor);
+
+  const GLsizei stride = sizeof(Vertex);
+  glEnableVertexAttribArray(ATTRIB_POSITION);
+  glEnableVertexAttribArray(ATTRIB_TEXCOORD);
+  glEnableVertexAttribArray(ATTRIB_COLOR);
+  glVertexAttribPointer(ATTRIB_POSITION, 2, GL_FLOAT, GL_FALSE, stride,
+                        reinterpret_cast<void*>(offset + offsetof(Vertex, x)));
+  glVertexAttribPointer(ATTRIB_TEXCOORD, 2, GL_FLOAT, GL_FALSE, stride,
+                        reinterpret_cast<void*>(offset + offsetof(Vertex, u)));
+  glVertexAttribPointer(ATTRIB_COLOR, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride,
+                        reinterpret_cast<void*>(offset + offsetof(Vertex, color)));
+
+  glDrawArrays(m_mode, 0, static_cast<GLsizei>(m_vertices.size()));
+
+  unbind_program();
+  m_vertices.clear();
+}
+
+void
+GLVBOPainter::draw_texture(const DrawingRequest& request)
+{
+  const auto& data = static_cast<const TextureRequest&>(request);
+  const auto& texture = static_cast<const GLTexture&>(*data.texture);
+
+  const float texture_width = static_cast<float>(texture.get_texture_width());
+  const float texture_height = static_cast<float>(texture.get_texture_height());
+
+  float uv_left = data.srcrect.get_left() / texture_width;
+  float uv_top = data.srcrect.get_top() / texture_height;
+  float uv_right = data.srcrect.get_right() / texture_width;
+  float uv_bottom = data.srcrect.get_bottom() / texture_height;
+
+  if (request.drawing_effect & HORIZONTAL_FLIP)
+    std::swap(uv_left, uv_right);
+
+  if (request.drawing_effect & VERTICAL_FLIP)
+    std::swap(uv_top, uv_bottom);
+
+  Color color = data.color;
+  color.alpha *= request.alpha;
+
+  begin(texture.get_handle(), request.blend, GL_TRIANGLES);
+  add_quad(data.dstrect, uv_left, uv_top, uv_right, uv_bottom, request.angle, color);
+}
+
+void
+GLVBOPainter::draw_texture_batch(const DrawingRequest& request)
+{
+  const auto& data = static_cast<const TextureBatchRequest&>(request);
+  const auto& texture = static_cast<const GLTexture&>(*data.texture);
+
+  assert(data.srcrects.size() == data.dstrects.size());
+
+  const float texture_width = static_cast<float>(texture.get_texture_width());
+  const float texture_height = static_cast<float>(texture.get_texture_height());
+
+  Color color = data.color;
+  color.alpha *= request.alpha;
+
+  begin(texture.get_handle(), request.blend, GL_TRIANGLES);
+  m_vertices.reserve(m_vertices.size() + data.srcrects.size() * 6);
+
+  for(size_t i = 0; i < data.srcrects.size(); ++i)
+  {
+    float uv_left = data.srcrects[i].get_left() / texture_width;
+    float uv_top = data.srcrects[i].get_top() / texture_height;
+    float uv_right = data.srcrects[i].get_right() / texture_width;
+    float uv_bottom = data.srcrects[i].get_bottom() / texture_height;
+
+    if (request.drawing_effect & HORIZONTAL_FLIP)
+      std::swap(uv_left, uv_right);
+
+    if (request.drawing_effect & VERTICAL_FLIP)
+      std::swap(uv_top, uv_bottom);
+
+    const float angle = data.angles.empty() ? 0.0f : data.angles[i];
+    add_quad(data.dstrects[i], uv_left, uv_top, uv_right, uv_bottom, angle, color);
+  }
+}
+
+void
+GLVBOPainter::draw_vertex_buffer(const DrawingRequest& request)
+{
+  const auto& data = static_cast<const VertexBufferRequest&>(request);
+  const auto& texture = static_cast<const GLTexture&>(*data.texture);
+  const auto& buffer = static_cast<const GLVertexBuffer&>(*data.buffer);
+
+  if (buffer.get_quad_count() == 0)
+    return;
+
+  // the buffer already lives on the GPU, draw it directly
+  flush();
+
+  bind_program(data.pos);
+  glBindTexture(GL_TEXTURE_2D, texture.get_handle());
+  glBlendFunc(request.blend.sfactor, request.blend.dfactor);
+
+  const GLsizei stride = 4 * sizeof(float);
+  glBindBuffer(GL_ARRAY_BUFFER, buffer.get_handle());
+  glEnableVertexAttribArray(ATTRIB_POSITION);
+  glEnableVertexAttribArray(ATTRIB_TEXCOORD);
+  glVertexAttribPointer(ATTRIB_POSITION, 2, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void*>(0));
+  glVertexAttribPointer(ATTRIB_TEXCOORD, 2, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void*>(2 * sizeof(float)));
+  glVertexAttrib4f(ATTRIB_COLOR, data.color.red, data.color.green, data.color.blue,
+                   data.color.alpha * request.alpha);
+
+  glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(buffer.get_quad_count() * 2 * 3));
+
+  unbind_program();
+}
+
+void
+GLVBOPainter::draw_gradient(const DrawingRequest& request)
+{
+  const auto& data = static_cast<const GradientRequest&>(request);
+
+  const Color& top = data.top;
+  const Color& bottom = data.bottom;
+  const Rectf& region = data.region;
+
+  // colors of the top left, top right, bottom right and bottom left corner
+  const bool vertical = (data.direction == VERTICAL || data.direction == VERTICAL_SECTOR);
+  const Color& c1 = top;
+  const Color& c2 = vertical ? top : bottom;
+  const Color& c3 = bottom;
+  const Color& c4 = vertical ? bottom : top;
+
+  begin(m_white_texture, Blend(), GL_TRIANGLES);
+
+  add_vertex(region.p1.x, region.p1.y, 0.0f, 0.0f, c1);
+  add_vertex(region.p2.x, region.p1.y, 0.0f, 0.0f, c2);
+  add_vertex(region.p2.x, region.p2.y, 0.0f, 0.0f, c3);
+
+  add_vertex(region.p1.x, region.p2.y, 0.0f, 0.0f, c4);
+  add_vertex(region.p1.x, region.p1.y, 0.0f, 0.0f, c1);
+  add_vertex(region.p2.x, region.p2.y, 0.0f, 0.0f, c3);
+}
+
+void
+GLVBOPainter::draw_filled_rect(const DrawingRequest& request)
+{
+  const auto& data = static_cast<const FillRectRequest&>(request);
+
+  begin(m_white_texture, Blend(), GL_TRIANGLES);
+
+  if (data.radius != 0.0f)
+  {
+    // draw round rect
+    // Keep radius in the limits, so that we get a circle instead of
+    // just graphic junk
+    float radius = std::min(data.radius,
+                            std::min(data.size.x/2,
+                                     data.size.y/2));
+
+    // inner rectangle
+    Rectf irect(data.pos.x    + radius,
+                data.pos.y    + radius,
+                data.pos.x + data.size.x - radius,
+                data.pos.y + data.size.y - radius);
+
+    // the same triangle strip as GLPainter draws, as list of triangles
+    int n = 8;
+    std::vector<Vector> strip;
+    strip.reserve((n+1) * 4);
+
+    for(int i = 0; i <= n; ++i)
+    {
+      float x = sinf(static_cast<float>(i) * math::PI_2 / static_cast<float>(n)) * radius;
+      float y = cosf(static_cast<float>(i) * math::PI_2 / static_cast<float>(n)) * radius;
+
+      strip.push_back(Vector(irect.get_left() - x, irect.get_top() - y));
+      strip.push_back(Vector(irect.get_right() + x, irect.get_top() - y));
+    }
+
+    for(int i = 0; i <= n; ++i)
+    {
+      float x = cosf(static_cast<float>(i) * math::PI_2 / static_cast<float>(n)) * radius;
+      float y = sinf(static_cast<float>(i) * math::PI_2 / static_cast<float>(n)) * radius;
+
+      strip.push_back(Vector(irect.get_left() - x, irect.get_bottom() + y));
+      strip.push_back(Vector(irect.get_right() + x, irect.get_bottom() + y));
+    }
+
+    for(size_t i = 2; i < strip.size(); ++i)
+    {
+      add_vertex(strip[i-2].x, strip[i-2].y, 0.0f, 0.0f, data.color);
+      add_vertex(strip[i-1].x, strip[i-1].y, 0.0f, 0.0f, data.color);
+      add_vertex(strip[i].x, strip[i].y, 0.0f, 0.0f, data.color);
+    }
+  }
+  else
+  {
+    add_quad(Rectf(data.pos, Sizef(data.size.x, data.size.y)),
+             0.0f, 0.0f, 0.0f, 0.0f, 0.0f, data.color);
+  }
+}
+
+void
+GLVBOPainter::draw_inverse_ellipse(const DrawingRequest& request)
+{
+  const auto& data = static_cast<const InverseEllipseRequest&>(request);
+
+  float x = data.pos.x;
+  float y = data.pos.y;
+  float w = data.size.x/2.0f;
+  float h = data.size.y/2.0f;
+
+  static const int slices = 16;
+
+  const Viewport& viewport = m_video_system.get_viewport();
+  float screen_width = static_cast<float>(viewport.get_screen_width());
+  float screen_height = static_cast<float>(viewport.get_screen_height());
+
+  begin(m_white_texture, Blend(), GL_TRIANGLES);
+
+  auto triangle = [this, &data](float x1, float y1, float x2, float y2, float x3, float y3)
+    {
+      add_vertex(x1, y1, 0.0f, 0.0f, data.color);
+      add_vertex(x2, y2, 0.0f, 0.0f, data.color);
+      add_vertex(x3, y3, 0.0f, 0.0f, data.color);
+    };
+
+  // Bottom
+  triangle(screen_width, screen_height, 0, screen_height, x, y+h);
+  // Top
+  triangle(screen_width, 0, 0, 0, x, y-h);
+  // Left
+  triangle(screen_width, 0, screen_width, screen_height, x+w, y);
+  // Right
+  triangle(0, 0, 0, screen_height, x-w, y);
+
+  for(int i = 0; i < slices; ++i)
+  {
+    float ex1 = sinf(math::PI_2 / static_cast<float>(slices) * static_cast<float>(i)) * w;
+    float ey1 = cosf(math::PI_2 / static_cast<float>(slices) * static_cast<float>(i)) * h;
+
+    float ex2 = sinf(math::PI_2 / static_cast<float>(slices) * static_cast<float>(i+1)) * w;
+    float ey2 = cosf(math::PI_2 / static_cast<float>(slices) * static_cast<float>(i+1)) * h;
+
+    // Bottom/Right
+    triangle(screen_width, screen_height, x + ex1, y + ey1, x + ex2, y + ey2);
+    // Top/Left
+    triangle(0, 0, x - ex1, y - ey1, x - ex2, y - ey2);
+    // Top/Right
+    triangle(screen_width, 0, x + ex1, y - ey1, x + ex2, y - ey2);
+    // Bottom/Left
+    triangle(0, screen_height, x - ex1, y + ey1, x - ex2, y + ey2);
+  }
+}
+
+void
+GLVBOPainter::draw_line(const DrawingRequest& request)
+{
+  const auto& data = static_cast<const LineRequest&>(request);
+
+  begin(m_white_texture, Blend(), GL_LINES);
+  add_vertex(data.pos.x, data.pos.y, 0.0f, 0.0f, data.color);
+  add_vertex(data.dest_pos.x, data.dest_pos.y, 0.0f, 0.0f, data.color);
+}
+
+void
+GLVBOPainter::draw_triangle(const DrawingRequest& request)
+{
+  const auto& data = static_cast<const TriangleRequest&>(request);
+
+  begin(m_white_texture, Blend(), GL_TRIANGLES);
+  add_vertex(data.pos1.x, data.pos1.y, 0.0f, 0.0f, data.color);
+  add_vertex(data.pos2.x, data.pos2.y, 0.0f, 0.0f, data.color);
+  add_vertex(data.pos3.x, data.pos3.y, 0.0f, 0.0f, data.color);
+}
+
+/* EOF */
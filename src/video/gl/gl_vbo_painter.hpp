@@ -0,0 +1,105 @@
+//  SuperTux
+//  Copyright (C) 2018 SuperTux Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_VIDEO_GL_GL_VBO_PAINTER_HPP
+#define HEADER_SUPERTUX_VIDEO_GL_GL_VBO_PAINTER_HPP
+
+#include <vector>
+
+#include "video/canvas.hpp"
+#include "video/glutil.hpp"
+#include "video/painter.hpp"
+
+class GLVideoSystem;
+struct DrawingRequest;
+
+/**
+ * Painter for OpenGL 2.0 and later. Instead of issuing one draw call
+ * per request from client side arrays, it collects the vertices of
+ * consecutive requests that share texture, blend mode and primitive
+ * type and draws them together from a streaming vertex buffer with a
+ * single shader program. Untextured primitives use a white texture so
+ * that they batch with each other. Vertices are only sent to OpenGL in
+ * flush(), which the renderer calls before touching the GL state itself.
+ */
+class GLVBOPainter final : public Painter
+{
+public:
+  /** Throws std::runtime_error when shaders are not available */
+  GLVBOPainter(GLVideoSystem& video_system);
+  ~GLVBOPainter();
+
+  virtual void draw_texture(const DrawingRequest& request) override;
+  virtual void draw_texture_batch(const DrawingRequest& request) override;
+  virtual void draw_vertex_buffer(const DrawingRequest& request) override;
+  virtual void draw_gradient(const DrawingRequest& request) override;
+  virtual void draw_filled_rect(const DrawingRequest& request) override;
+  virtual void draw_inverse_ellipse(const DrawingRequest& request) override;
+  virtual void draw_line(const DrawingRequest& request) override;
+  virtual void draw_triangle(const DrawingRequest& request) override;
+
+  virtual void flush() override;
+
+private:
+  struct Vertex
+  {
+    float x, y;
+    float u, v;
+    GLubyte color[4];
+  };
+
+  /** Starts or continues a batch, flushes first if the state differs */
+  void begin(GLuint texture, const Blend& blend, GLenum mode);
+  void add_vertex(float x, float y, float u, float v, const Color& color);
+  void add_quad(const Rectf& dstrect, float uv_left, float uv_top,
+                float uv_right, float uv_bottom, float angle, const Color& color);
+
+  /** Copies the pending vertices into the stream buffer, returns the
+      byte offset they were placed at */
+  size_t upload();
+  void bind_program(const Vector& offset);
+  void unbind_program();
+
+  void create_program();
+  void create_white_texture();
+
+private:
+  GLVideoSystem& m_video_system;
+
+  GLuint m_program;
+  GLint m_offset_location;
+  GLint m_texture_location;
+  GLuint m_white_texture;
+
+  /** buffer the batches are streamed into, orphaned when full */
+  GLuint m_stream_buffer;
+  size_t m_stream_capacity;
+  size_t m_stream_offset;
+
+  /** pending batch */
+  std::vector<Vertex> m_vertices;
+  GLuint m_texture;
+  Blend m_blend;
+  GLenum m_mode;
+
+private:
+  GLVBOPainter(const GLVBOPainter&) = delete;
+  GLVBOPainter& operator=(const GLVBOPainter&) = delete;
+};
+
+#endif
+
+/* EOF */
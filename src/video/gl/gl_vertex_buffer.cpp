@@ -0,0 +1,88 @@
+//  SuperTux
+//  Copyright (C) 2018 SuperTux Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "video/gl/gl_vertex_buffer.hpp"
+
+#include <algorithm>
+#include <assert.h>
+
+#include "video/texture.hpp"
+
+GLVertexBuffer::GLVertexBuffer() :
+  m_handle(),
+  m_quad_count(0)
+{
+  glGenBuffers(1, &m_handle);
+}
+
+GLVertexBuffer::~GLVertexBuffer()
+{
+  glDeleteBuffers(1, &m_handle);
+}
+
+void
+GLVertexBuffer::set_quads(const Texture& texture,
+                          const std::vector<Rectf>& srcrects,
+                          const std::vector<Rectf>& dstrects,
+                          DrawingEffect effect)
+{
+  assert(srcrects.size() == dstrects.size());
+
+  const float texture_width = static_cast<float>(texture.get_texture_width());
+  const float texture_height = static_cast<float>(texture.get_texture_height());
+
+  std::vector<float> vertices;
+  vertices.reserve(srcrects.size() * 6 * 4);
+  for(size_t i = 0; i < srcrects.size(); ++i)
+  {
+    const float left = dstrects[i].p1.x;
+    const float top = dstrects[i].p1.y;
+    const float right  = dstrects[i].p2.x;
+    const float bottom = dstrects[i].p2.y;
+
+    float uv_left = srcrects[i].get_left() / texture_width;
+    float uv_top = srcrects[i].get_top() / texture_height;
+    float uv_right = srcrects[i].get_right() / texture_width;
+    float uv_bottom = srcrects[i].get_bottom() / texture_height;
+
+    if (effect & HORIZONTAL_FLIP)
+      std::swap(uv_left, uv_right);
+
+    if (effect & VERTICAL_FLIP)
+      std::swap(uv_top, uv_bottom);
+
+    auto quad = {
+      left, top, uv_left, uv_top,
+      right, top, uv_right, uv_top,
+      right, bottom, uv_right, uv_bottom,
+
+      left, bottom, uv_left, uv_bottom,
+      left, top, uv_left, uv_top,
+      right, bottom, uv_right, uv_bottom,
+    };
+
+    vertices.insert(vertices.end(), std::begin(quad), std::end(quad));
+  }
+
+  glBindBuffer(GL_ARRAY_BUFFER, m_handle);
+  glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float),
+               vertices.data(), GL_STATIC_DRAW);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+  m_quad_count = srcrects.size();
+}
+
+/* EOF */
@@ -0,0 +1,57 @@
+//  SuperTux
+//  Copyright (C) 2018 SuperTux Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_VIDEO_GL_GL_VERTEX_BUFFER_HPP
+#define HEADER_SUPERTUX_VIDEO_GL_GL_VERTEX_BUFFER_HPP
+
+#include "video/glutil.hpp"
+#include "video/vertex_buffer.hpp"
+
+/** VertexBuffer stored in an OpenGL buffer object, the vertices are
+    interleaved as x, y, u, v and form two triangles per quad */
+class GLVertexBuffer final : public VertexBuffer
+{
+public:
+  GLVertexBuffer();
+  ~GLVertexBuffer();
+
+  virtual void set_quads(const Texture& texture,
+                         const std::vector<Rectf>& srcrects,
+                         const std::vector<Rectf>& dstrects,
+                         DrawingEffect effect) override;
+
+  virtual size_t get_quad_count() const override
+  {
+    return m_quad_count;
+  }
+
+  GLuint get_handle() const
+  {
+    return m_handle;
+  }
+
+private:
+  GLuint m_handle;
+  size_t m_quad_count;
+
+private:
+  GLVertexBuffer(const GLVertexBuffer&) = delete;
+  GLVertexBuffer& operator=(const GLVertexBuffer&) = delete;
+};
+
+#endif
+
+/* EOF */
@@ -28,10 +28,14 @@
 #include "supertux/globals.hpp"
 #include "util/log.hpp"
 #include "video/gl/gl_lightmap.hpp"
+#include "video/gl/gl_painter.hpp"
 #include "video/gl/gl_renderer.hpp"
 #include "video/gl/gl_texture.hpp"
+#include "video/gl/gl_vbo_painter.hpp"
+#include "video/gl/gl_vertex_buffer.hpp"
 
-GLVideoSystem::GLVideoSystem() :
+GLVideoSystem::GLVideoSystem(bool use_vbo) :
+  m_use_vbo(use_vbo),
   m_texture_manager(),
   m_renderer(),
   m_lightmap(),
@@ -267,6 +271,12 @@ GLVideoSystem::new_texture(SDL_Surface* image)
   return TexturePtr(new GLTexture(image));
 }
 
+std::unique_ptr<VertexBuffer>
+GLVideoSystem::new_vertex_buffer()
+{
+  return std::unique_ptr<VertexBuffer>(new GLVertexBuffer);
+}
+
 void
 GLVideoSystem::flip()
 {
@@ -302,6 +312,25 @@ GLVideoSystem::set_icon(SDL_Surface* icon)
   SDL_SetWindowIcon(m_window, icon);
 }
 
+std::unique_ptr<Painter>
+GLVideoSystem::create_painter()
+{
+  if (m_use_vbo)
+  {
+    try
+    {
+      return std::unique_ptr<Painter>(new GLVBOPainter(*this));
+    }
+    catch(std::exception& err)
+    {
+      log_warning << "Error creating GLVBOPainter, using fixed function fallback: " << err.what() << std::endl;
+      m_use_vbo = false;
+    }
+  }
+
+  return std::unique_ptr<Painter>(new GLPainter(*this));
+}
+
 Size
 GLVideoSystem::get_window_size() const
 {
@@ -26,6 +26,7 @@
 
 class GLRenderer;
 class GLLightmap;
+class Painter;
 class Rect;
 class TextureManager;
 struct SDL_Surface;
@@ -33,13 +34,16 @@ struct SDL_Surface;
 class GLVideoSystem final : public VideoSystem
 {
 public:
-  GLVideoSystem();
+  /** use_vbo selects GLVBOPainter, GLPainter is used when it is not
+      set or when the OpenGL implementation can't run GLVBOPainter */
+  GLVideoSystem(bool use_vbo = false);
   ~GLVideoSystem();
 
   virtual Renderer& get_renderer() const override;
   virtual Lightmap& get_lightmap() const override;
 
   virtual TexturePtr new_texture(SDL_Surface* image) override;
+  virtual std::unique_ptr<VertexBuffer> new_vertex_buffer() override;
 
   virtual const Viewport& get_viewport() const override { return m_viewport; }
   virtual void apply_config() override;
@@ -54,11 +58,15 @@ public:
 
   Size get_window_size() const;
 
+  /** Creates the painter for GLRenderer and GLLightmap */
+  std::unique_ptr<Painter> create_painter();
+
 private:
   void create_window();
   void apply_video_mode();
 
 private:
+  bool m_use_vbo;
   std::unique_ptr<TextureManager> m_texture_manager;
   std::unique_ptr<GLRenderer> m_renderer;
   std::unique_ptr<GLLightmap> m_lightmap;
@@ -0,0 +1,103 @@
+//  SuperTux
+//  Copyright (C) 2018 SuperTux Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_VIDEO_GLYPH_TABLE_HPP
+#define HEADER_SUPERTUX_VIDEO_GLYPH_TABLE_HPP
+
+#include <algorithm>
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+/**
+ * Maps codepoints to glyphs. The first 256 codepoints are kept in a
+ * plain array for the common Latin-1 text, all others in a sorted
+ * array that only holds the glyphs a font actually has. Codepoints
+ * without a glyph return a default constructed T.
+ */
+template<class T>
+class GlyphTable final
+{
+public:
+  GlyphTable() :
+    m_missing(),
+    m_direct(DIRECT_SIZE),
+    m_codepoints(),
+    m_glyphs()
+  {}
+
+  const T& get(uint32_t codepoint) const
+  {
+    if (codepoint < DIRECT_SIZE)
+      return m_direct[codepoint];
+
+    auto it = std::lower_bound(m_codepoints.begin(), m_codepoints.end(), codepoint);
+    if (it == m_codepoints.end() || *it != codepoint)
+      return m_missing;
+    return m_glyphs[it - m_codepoints.begin()];
+  }
+
+  void set(uint32_t codepoint, const T& glyph)
+  {
+    if (codepoint < DIRECT_SIZE)
+    {
+      m_direct[codepoint] = glyph;
+      return;
+    }
+
+    // font files list their characters mostly in ascending order, so
+    // this usually appends
+    auto it = std::lower_bound(m_codepoints.begin(), m_codepoints.end(), codepoint);
+    auto idx = it - m_codepoints.begin();
+    if (it != m_codepoints.end() && *it == codepoint)
+    {
+      m_glyphs[idx] = glyph;
+    }
+    else
+    {
+      m_codepoints.insert(it, codepoint);
+      m_glyphs.insert(m_glyphs.begin() + idx, glyph);
+    }
+  }
+
+  /** number of glyphs outside of the plain array */
+  size_t get_sparse_count() const { return m_codepoints.size(); }
+
+  /** approximate memory used by the table in bytes */
+  size_t get_memory_usage() const
+  {
+    return sizeof(*this) +
+      m_direct.capacity() * sizeof(T) +
+      m_codepoints.capacity() * sizeof(uint32_t) +
+      m_glyphs.capacity() * sizeof(T);
+  }
+
+private:
+  static const uint32_t DIRECT_SIZE = 256;
+
+  T m_missing;
+  std::vector<T> m_direct;
+  std::vector<uint32_t> m_codepoints;
+  std::vector<T> m_glyphs;
+
+private:
+  GlyphTable(const GlyphTable&) = delete;
+  GlyphTable& operator=(const GlyphTable&) = delete;
+};
+
+#endif
+
+/* EOF */
@@ -0,0 +1,93 @@
+//  SuperTux
+//  Copyright (C) 2018 SuperTux Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "video/layer_sorter.hpp"
+
+#include <algorithm>
+
+#include "video/drawing_request.hpp"
+
+namespace {
+
+// larger ranges of layers would make the offset table too expensive
+const int MAX_LAYER_RANGE = 1 << 16;
+
+} // namespace
+
+LayerSorter::LayerSorter() :
+  m_buffer(),
+  m_offsets()
+{
+}
+
+void
+LayerSorter::sort(std::vector<DrawingRequest*>& requests)
+{
+  if (requests.size() < 2)
+    return;
+
+  int min_layer = requests.front()->layer;
+  int max_layer = min_layer;
+  bool sorted = true;
+  for(size_t i = 1; i < requests.size(); ++i)
+  {
+    int layer = requests[i]->layer;
+    if (layer < requests[i - 1]->layer)
+      sorted = false;
+    min_layer = std::min(min_layer, layer);
+    max_layer = std::max(max_layer, layer);
+  }
+
+  if (sorted)
+    return;
+
+  if (static_cast<long long>(max_layer) - min_layer >= MAX_LAYER_RANGE)
+  {
+    std::stable_sort(requests.begin(), requests.end(),
+                     [](const DrawingRequest* r1, const DrawingRequest* r2){
+                       return r1->layer < r2->layer;
+                     });
+    return;
+  }
+
+  // count the requests per layer, then turn the counts into the
+  // offset of the first request of each layer
+  const size_t range = static_cast<size_t>(max_layer - min_layer) + 1;
+  m_offsets.assign(range, 0);
+  for(const auto& request : requests)
+  {
+    m_offsets[request->layer - min_layer] += 1;
+  }
+
+  size_t offset = 0;
+  for(auto& count : m_offsets)
+  {
+    size_t next = offset + count;
+    count = offset;
+    offset = next;
+  }
+
+  m_buffer.resize(requests.size());
+  for(const auto& request : requests)
+  {
+    m_buffer[m_offsets[request->layer - min_layer]++] = request;
+  }
+
+  requests.swap(m_buffer);
+}
+
+/* EOF */
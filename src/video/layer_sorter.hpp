@@ -0,0 +1,51 @@
+//  SuperTux
+//  Copyright (C) 2018 SuperTux Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef HEADER_SUPERTUX_VIDEO_LAYER_SORTER_HPP
+#define HEADER_SUPERTUX_VIDEO_LAYER_SORTER_HPP
+
+#include <stddef.h>
+#include <vector>
+
+struct DrawingRequest;
+
+/**
+ * Stable sort of DrawingRequests by layer. Layers span only a small
+ * range of ints, so a counting sort is used, which is O(n) and,
+ * once the internal buffers have grown, free of allocations. Requests
+ * spread over an unusually large range of layers fall back to
+ * std::stable_sort().
+ */
+class LayerSorter final
+{
+public:
+  LayerSorter();
+
+  void sort(std::vector<DrawingRequest*>& requests);
+
+private:
+  std::vector<DrawingRequest*> m_buffer;
+  std::vector<size_t> m_offsets;
+
+private:
+  LayerSorter(const LayerSorter&) = delete;
+  LayerSorter& operator=(const LayerSorter&) = delete;
+};
+
+#endif
+
+/* EOF */
@@ -34,6 +34,9 @@ public:
   virtual Painter& get_painter() = 0;
   virtual void clear(const Color& color = Color(0.0f, 0.0f, 0.0f, 1.0f)) = 0;
 
+  /** Answers a GetLightRequest. Implementations may answer from a
+      copy of the previous frame's lightmap, so that reading it back
+      doesn't stall the rendering. */
   virtual void get_light(const DrawingRequest& request) const = 0;
 
   virtual void set_clip_rect(const Rect& rect) = 0;
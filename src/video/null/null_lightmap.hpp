@@ -0,0 +1,58 @@
+//  SuperTux
+//  Copyright (C) 2018 SuperTux Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef HEADER_SUPERTUX_VIDEO_NULL_NULL_LIGHTMAP_HPP
+#define HEADER_SUPERTUX_VIDEO_NULL_NULL_LIGHTMAP_HPP
+
+#include "video/drawing_request.hpp"
+#include "video/lightmap.hpp"
+#include "video/null/null_painter.hpp"
+
+class NullLightmap final : public Lightmap
+{
+public:
+  NullLightmap() : m_painter() {}
+
+  virtual void start_draw() override {}
+  virtual void end_draw() override {}
+
+  virtual NullPainter& get_painter() override { return m_painter; }
+  virtual void clear(const Color&) override {}
+
+  /** Nothing is rendered, so every position is reported as fully lit */
+  virtual void get_light(const DrawingRequest& request) const override
+  {
+    const auto& data = static_cast<const GetLightRequest&>(request);
+    *(data.color_ptr) = Color(1.0f, 1.0f, 1.0f);
+  }
+
+  virtual void set_clip_rect(const Rect&) override {}
+  virtual void clear_clip_rect() override {}
+
+  virtual void render() override {}
+
+private:
+  NullPainter m_painter;
+
+private:
+  NullLightmap(const NullLightmap&) = delete;
+  NullLightmap& operator=(const NullLightmap&) = delete;
+};
+
+#endif
+
+/* EOF */
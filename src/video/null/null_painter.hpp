@@ -0,0 +1,45 @@
+//  SuperTux
+//  Copyright (C) 2018 SuperTux Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef HEADER_SUPERTUX_VIDEO_NULL_NULL_PAINTER_HPP
+#define HEADER_SUPERTUX_VIDEO_NULL_NULL_PAINTER_HPP
+
+#include "video/painter.hpp"
+
+/** Painter that discards everything, used for headless benchmarks */
+class NullPainter final : public Painter
+{
+public:
+  NullPainter() {}
+
+  virtual void draw_texture(const DrawingRequest&) override {}
+  virtual void draw_texture_batch(const DrawingRequest&) override {}
+  virtual void draw_vertex_buffer(const DrawingRequest&) override {}
+  virtual void draw_gradient(const DrawingRequest&) override {}
+  virtual void draw_filled_rect(const DrawingRequest&) override {}
+  virtual void draw_inverse_ellipse(const DrawingRequest&) override {}
+  virtual void draw_line(const DrawingRequest&) override {}
+  virtual void draw_triangle(const DrawingRequest&) override {}
+
+private:
+  NullPainter(const NullPainter&) = delete;
+  NullPainter& operator=(const NullPainter&) = delete;
+};
+
+#endif
+
+/* EOF */
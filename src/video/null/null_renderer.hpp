@@ -0,0 +1,48 @@
+//  SuperTux
+//  Copyright (C) 2018 SuperTux Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef HEADER_SUPERTUX_VIDEO_NULL_NULL_RENDERER_HPP
+#define HEADER_SUPERTUX_VIDEO_NULL_NULL_RENDERER_HPP
+
+#include "video/null/null_painter.hpp"
+#include "video/renderer.hpp"
+
+class NullRenderer final : public Renderer
+{
+public:
+  NullRenderer() : m_painter() {}
+
+  virtual void start_draw() override {}
+  virtual void end_draw() override {}
+
+  virtual NullPainter& get_painter() override { return m_painter; }
+  virtual void clear(const Color&) override {}
+
+  virtual void set_clip_rect(const Rect&) override {}
+  virtual void clear_clip_rect() override {}
+
+private:
+  NullPainter m_painter;
+
+private:
+  NullRenderer(const NullRenderer&) = delete;
+  NullRenderer& operator=(const NullRenderer&) = delete;
+};
+
+#endif
+
+/* EOF */
@@ -0,0 +1,52 @@
+//  SuperTux
+//  Copyright (C) 2018 SuperTux Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef HEADER_SUPERTUX_VIDEO_NULL_NULL_TEXTURE_HPP
+#define HEADER_SUPERTUX_VIDEO_NULL_NULL_TEXTURE_HPP
+
+#include <SDL.h>
+
+#include "video/texture.hpp"
+
+/** Texture that only remembers the size of its image */
+class NullTexture final : public Texture
+{
+public:
+  NullTexture(SDL_Surface* image) :
+    m_width(static_cast<unsigned int>(image->w)),
+    m_height(static_cast<unsigned int>(image->h))
+  {}
+
+  virtual unsigned int get_texture_width() const override { return m_width; }
+  virtual unsigned int get_texture_height() const override { return m_height; }
+  virtual unsigned int get_image_width() const override { return m_width; }
+  virtual unsigned int get_image_height() const override { return m_height; }
+
+  virtual void update_region(SDL_Surface*, int, int) override {}
+
+private:
+  unsigned int m_width;
+  unsigned int m_height;
+
+private:
+  NullTexture(const NullTexture&) = delete;
+  NullTexture& operator=(const NullTexture&) = delete;
+};
+
+#endif
+
+/* EOF */
@@ -0,0 +1,48 @@
+//  SuperTux
+//  Copyright (C) 2018 SuperTux Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef HEADER_SUPERTUX_VIDEO_NULL_NULL_VERTEX_BUFFER_HPP
+#define HEADER_SUPERTUX_VIDEO_NULL_NULL_VERTEX_BUFFER_HPP
+
+#include "video/vertex_buffer.hpp"
+
+class NullVertexBuffer final : public VertexBuffer
+{
+public:
+  NullVertexBuffer() : m_quad_count(0) {}
+
+  virtual void set_quads(const Texture&,
+                         const std::vector<Rectf>& srcrects,
+                         const std::vector<Rectf>&,
+                         DrawingEffect) override
+  {
+    m_quad_count = srcrects.size();
+  }
+
+  virtual size_t get_quad_count() const override { return m_quad_count; }
+
+private:
+  size_t m_quad_count;
+
+private:
+  NullVertexBuffer(const NullVertexBuffer&) = delete;
+  NullVertexBuffer& operator=(const NullVertexBuffer&) = delete;
+};
+
+#endif
+
+/* EOF */
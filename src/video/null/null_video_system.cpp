@@ -0,0 +1,81 @@
+//  SuperTux
+//  Copyright (C) 2018 SuperTux Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "video/null/null_video_system.hpp"
+
+#include "supertux/gameconfig.hpp"
+#include "supertux/globals.hpp"
+#include "util/log.hpp"
+#include "video/null/null_lightmap.hpp"
+#include "video/null/null_renderer.hpp"
+#include "video/null/null_texture.hpp"
+#include "video/null/null_vertex_buffer.hpp"
+#include "video/texture_manager.hpp"
+
+NullVideoSystem::NullVideoSystem() :
+  m_viewport(),
+  m_renderer(new NullRenderer),
+  m_lightmap(new NullLightmap),
+  m_texture_manager()
+{
+  log_info << "creating NullVideoSystem, nothing will be displayed" << std::endl;
+  m_texture_manager.reset(new TextureManager);
+  apply_config();
+}
+
+NullVideoSystem::~NullVideoSystem()
+{
+}
+
+void
+NullVideoSystem::apply_config()
+{
+  m_viewport = Viewport::from_size(g_config->window_size, g_config->window_size);
+}
+
+Renderer&
+NullVideoSystem::get_renderer() const
+{
+  return *m_renderer;
+}
+
+Lightmap&
+NullVideoSystem::get_lightmap() const
+{
+  return *m_lightmap;
+}
+
+TexturePtr
+NullVideoSystem::new_texture(SDL_Surface* image)
+{
+  return TexturePtr(new NullTexture(image));
+}
+
+std::unique_ptr<VertexBuffer>
+NullVideoSystem::new_vertex_buffer()
+{
+  return std::unique_ptr<VertexBuffer>(new NullVertexBuffer);
+}
+
+void
+NullVideoSystem::on_resize(int w, int h)
+{
+  g_config->window_size = Size(w, h);
+  apply_config();
+}
+
+/* EOF */
@@ -0,0 +1,71 @@
+//  SuperTux
+//  Copyright (C) 2018 SuperTux Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef HEADER_SUPERTUX_VIDEO_NULL_NULL_VIDEO_SYSTEM_HPP
+#define HEADER_SUPERTUX_VIDEO_NULL_NULL_VIDEO_SYSTEM_HPP
+
+#include <memory>
+
+#include "video/video_system.hpp"
+#include "video/viewport.hpp"
+
+class NullLightmap;
+class NullRenderer;
+class TextureManager;
+
+/**
+ * VideoSystem without a window that loads images but draws nothing,
+ * so the game can run headless, e.g. for benchmarks. The viewport
+ * still follows the configured window size, so the same part of the
+ * level is drawn into the Canvas as with a real renderer.
+ */
+class NullVideoSystem final : public VideoSystem
+{
+public:
+  NullVideoSystem();
+  ~NullVideoSystem();
+
+  virtual Renderer& get_renderer() const override;
+  virtual Lightmap& get_lightmap() const override;
+
+  virtual TexturePtr new_texture(SDL_Surface* image) override;
+  virtual std::unique_ptr<VertexBuffer> new_vertex_buffer() override;
+
+  virtual const Viewport& get_viewport() const override { return m_viewport; }
+  virtual void apply_config() override;
+  virtual void flip() override {}
+  virtual void on_resize(int w, int h) override;
+
+  virtual void set_gamma(float) override {}
+  virtual void set_title(const std::string&) override {}
+  virtual void set_icon(SDL_Surface*) override {}
+  virtual SDL_Surface* make_screenshot() override { return nullptr; }
+
+private:
+  Viewport m_viewport;
+  std::unique_ptr<NullRenderer> m_renderer;
+  std::unique_ptr<NullLightmap> m_lightmap;
+  std::unique_ptr<TextureManager> m_texture_manager;
+
+private:
+  NullVideoSystem(const NullVideoSystem&) = delete;
+  NullVideoSystem& operator=(const NullVideoSystem&) = delete;
+};
+
+#endif
+
+/* EOF */
@@ -34,12 +34,17 @@ public:
 
   virtual void draw_texture(const DrawingRequest& request) = 0;
   virtual void draw_texture_batch(const DrawingRequest& request) = 0;
+  virtual void draw_vertex_buffer(const DrawingRequest& request) = 0;
   virtual void draw_gradient(const DrawingRequest& request) = 0;
   virtual void draw_filled_rect(const DrawingRequest& request) = 0;
   virtual void draw_inverse_ellipse(const DrawingRequest& request) = 0;
   virtual void draw_line(const DrawingRequest& request) = 0;
   virtual void draw_triangle(const DrawingRequest& request) = 0;
 
+  /** Submits draws the painter has queued up, called before the
+      renderer changes state behind the painter's back */
+  virtual void flush() {}
+
 private:
   Painter(const Painter&) = delete;
   Painter& operator=(const Painter&) = delete;
@@ -16,6 +16,7 @@
 
 #include "video/sdl/sdl_lightmap.hpp"
 
+#include "math/util.hpp"
 #include "supertux/globals.hpp"
 #include "util/log.hpp"
 #include "video/drawing_request.hpp"
@@ -31,7 +32,11 @@ SDLLightmap::SDLLightmap(SDLVideoSystem& video_system, SDL_Renderer* renderer, c
   m_size(size),
   m_texture(),
   m_LIGHTMAP_DIV(),
-  m_cliprect()
+  m_cliprect(),
+  m_pixels(),
+  m_pixels_width(),
+  m_pixels_height(),
+  m_readback_requested(false)
 {
   m_LIGHTMAP_DIV = 5;
 }
@@ -69,6 +74,33 @@ void
 SDLLightmap::end_draw()
 {
   SDL_RenderSetScale(m_renderer, 1.0f, 1.0f);
+
+  if (m_readback_requested)
+  {
+    m_readback_requested = false;
+
+    // read the whole lightmap once, instead of once per get_light()
+    int w, h;
+    SDL_QueryTexture(m_texture, NULL, NULL, &w, &h);
+    m_pixels.resize(w * h);
+    int ret = SDL_RenderReadPixels(m_renderer, NULL,
+                                   SDL_PIXELFORMAT_RGB888,
+                                   m_pixels.data(),
+                                   w * static_cast<int>(sizeof(Uint32)));
+    if (ret != 0)
+    {
+      log_warning << "failed to read pixels: " << SDL_GetError() << std::endl;
+      m_pixels.clear();
+    }
+    m_pixels_width = w;
+    m_pixels_height = h;
+  }
+  else
+  {
+    // nobody asked for the light, don't stall on the readback
+    m_pixels.clear();
+  }
+
   SDL_SetRenderTarget(m_renderer, NULL);
 }
 
@@ -121,6 +153,22 @@ SDLLightmap::get_light(const DrawingRequest& request) const
 {
   const auto& data = static_cast<const GetLightRequest&>(request);
 
+  m_readback_requested = true;
+
+  if (!m_pixels.empty())
+  {
+    int x = math::clamp(static_cast<int>(data.pos.x / static_cast<float>(m_LIGHTMAP_DIV)), 0, m_pixels_width - 1);
+    int y = math::clamp(static_cast<int>(data.pos.y / static_cast<float>(m_LIGHTMAP_DIV)), 0, m_pixels_height - 1);
+    Uint32 pixel = m_pixels[y * m_pixels_width + x];
+
+    *(data.color_ptr) = Color::from_rgb888(static_cast<Uint8>((pixel >> 16) & 0xff),
+                                           static_cast<Uint8>((pixel >> 8) & 0xff),
+                                           static_cast<Uint8>(pixel & 0xff));
+    return;
+  }
+
+  // nothing read back in the last frame, happens on the first frame
+  // with light queries
   SDL_Rect rect;
   rect.x = static_cast<int>(data.pos.x / static_cast<float>(m_LIGHTMAP_DIV));
   rect.y = static_cast<int>(data.pos.y / static_cast<float>(m_LIGHTMAP_DIV));
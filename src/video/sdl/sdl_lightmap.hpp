@@ -21,6 +21,7 @@
 
 #include <SDL.h>
 #include <boost/optional.hpp>
+#include <vector>
 
 #include "video/sdl/sdl_painter.hpp"
 
@@ -58,6 +59,13 @@ private:
   int m_LIGHTMAP_DIV;
   boost::optional<SDL_Rect> m_cliprect;
 
+  /** copy of the previous frame's lightmap, read back in end_draw()
+      of frames with get_light() calls and used by get_light() */
+  std::vector<Uint32> m_pixels;
+  int m_pixels_width;
+  int m_pixels_height;
+  mutable bool m_readback_requested;
+
 private:
   SDLLightmap(const SDLLightmap&);
   SDLLightmap& operator=(const SDLLightmap&);
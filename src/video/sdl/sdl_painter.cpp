@@ -23,6 +23,7 @@
 #include "util/log.hpp"
 #include "video/drawing_request.hpp"
 #include "video/sdl/sdl_texture.hpp"
+#include "video/sdl/sdl_vertex_buffer.hpp"
 #include "video/sdl/sdl_video_system.hpp"
 #include "video/viewport.hpp"
 
@@ -147,7 +148,56 @@ SDLPainter::draw_texture_batch(const DrawingRequest& request)
       flip = static_cast<SDL_RendererFlip>(flip | SDL_FLIP_VERTICAL);
     }
 
-    SDL_RenderCopyEx(m_renderer, texture.get_texture(), &src_rect, &dst_rect, request.angle, NULL, flip);
+    const double angle = data.angles.empty() ? request.angle : data.angles[i];
+    SDL_RenderCopyEx(m_renderer, texture.get_texture(), &src_rect, &dst_rect, angle, NULL, flip);
+  }
+}
+
+void
+SDLPainter::draw_vertex_buffer(const DrawingRequest& request)
+{
+  const auto& data = static_cast<const VertexBufferRequest&>(request);
+  const auto& texture = static_cast<const SDLTexture&>(*data.texture);
+  const auto& buffer = static_cast<const SDLVertexBuffer&>(*data.buffer);
+
+  const auto& srcrects = buffer.get_srcrects();
+  const auto& dstrects = buffer.get_dstrects();
+
+  Uint8 r = static_cast<Uint8>(data.color.red * 255);
+  Uint8 g = static_cast<Uint8>(data.color.green * 255);
+  Uint8 b = static_cast<Uint8>(data.color.blue * 255);
+  Uint8 a = static_cast<Uint8>(data.color.alpha * request.alpha * 255);
+
+  SDL_SetTextureColorMod(texture.get_texture(), r, g, b);
+  SDL_SetTextureAlphaMod(texture.get_texture(), a);
+  SDL_SetTextureBlendMode(texture.get_texture(), blend2sdl(request.blend));
+
+  SDL_RendererFlip flip = SDL_FLIP_NONE;
+  if ((buffer.get_effect() & HORIZONTAL_FLIP) != 0)
+  {
+    flip = static_cast<SDL_RendererFlip>(flip | SDL_FLIP_HORIZONTAL);
+  }
+
+  if ((buffer.get_effect() & VERTICAL_FLIP) != 0)
+  {
+    flip = static_cast<SDL_RendererFlip>(flip | SDL_FLIP_VERTICAL);
+  }
+
+  for(size_t i = 0; i < srcrects.size(); ++i)
+  {
+    SDL_Rect src_rect;
+    src_rect.x = static_cast<int>(srcrects[i].p1.x);
+    src_rect.y = static_cast<int>(srcrects[i].p1.y);
+    src_rect.w = static_cast<int>(srcrects[i].get_width());
+    src_rect.h = static_cast<int>(srcrects[i].get_height());
+
+    SDL_Rect dst_rect;
+    dst_rect.x = static_cast<int>(dstrects[i].p1.x + data.pos.x);
+    dst_rect.y = static_cast<int>(dstrects[i].p1.y + data.pos.y);
+    dst_rect.w = static_cast<int>(dstrects[i].get_width());
+    dst_rect.h = static_cast<int>(dstrects[i].get_height());
+
+    SDL_RenderCopyEx(m_renderer, texture.get_texture(), &src_rect, &dst_rect, 0.0, NULL, flip);
   }
 }
 
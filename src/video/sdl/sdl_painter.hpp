@@ -30,6 +30,7 @@ public:
 
   virtual void draw_texture(const DrawingRequest& request) override;
   virtual void draw_texture_batch(const DrawingRequest& request) override;
+  virtual void draw_vertex_buffer(const DrawingRequest& request) override;
   virtual void draw_gradient(const DrawingRequest& request) override;
   virtual void draw_filled_rect(const DrawingRequest& request) override;
   virtual void draw_inverse_ellipse(const DrawingRequest& request) override;
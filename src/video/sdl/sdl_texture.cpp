@@ -19,6 +19,7 @@
 #include <SDL.h>
 
 #include "video/sdl/sdl_renderer.hpp"
+#include "video/sdl_surface_ptr.hpp"
 #include "video/video_system.hpp"
 
 SDLTexture::SDLTexture(SDL_Surface* image) :
@@ -39,6 +40,29 @@ SDLTexture::SDLTexture(SDL_Surface* image) :
   m_height = image->h;
 }
 
+void
+SDLTexture::update_region(SDL_Surface* image, int x, int y)
+{
+  Uint32 format;
+  SDL_QueryTexture(m_texture, &format, NULL, NULL, NULL);
+
+  SDLSurfacePtr convert(SDL_ConvertSurfaceFormat(image, format, 0));
+  if (!convert)
+  {
+    std::ostringstream msg;
+    msg << "couldn't update texture: " << SDL_GetError();
+    throw std::runtime_error(msg.str());
+  }
+
+  SDL_Rect rect = { x, y, convert->w, convert->h };
+  if (SDL_UpdateTexture(m_texture, &rect, convert->pixels, convert->pitch) != 0)
+  {
+    std::ostringstream msg;
+    msg << "couldn't update texture: " << SDL_GetError();
+    throw std::runtime_error(msg.str());
+  }
+}
+
 SDLTexture::~SDLTexture()
 {
   SDL_DestroyTexture(m_texture);
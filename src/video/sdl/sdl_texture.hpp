@@ -57,6 +57,8 @@ public:
     return m_height;
   }
 
+  void update_region(SDL_Surface* image, int x, int y) override;
+
 private:
   SDLTexture(const SDLTexture&);
   SDLTexture& operator=(const SDLTexture&);
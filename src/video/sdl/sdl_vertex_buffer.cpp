@@ -0,0 +1,41 @@
+//  SuperTux
+//  Copyright (C) 2018 SuperTux Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "video/sdl/sdl_vertex_buffer.hpp"
+
+#include <assert.h>
+
+SDLVertexBuffer::SDLVertexBuffer() :
+  m_srcrects(),
+  m_dstrects(),
+  m_effect(NO_EFFECT)
+{
+}
+
+void
+SDLVertexBuffer::set_quads(const Texture& /*texture*/,
+                           const std::vector<Rectf>& srcrects,
+                           const std::vector<Rectf>& dstrects,
+                           DrawingEffect effect)
+{
+  assert(srcrects.size() == dstrects.size());
+
+  m_srcrects = srcrects;
+  m_dstrects = dstrects;
+  m_effect = effect;
+}
+
+/* EOF */
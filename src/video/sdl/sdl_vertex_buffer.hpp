@@ -0,0 +1,55 @@
+//  SuperTux
+//  Copyright (C) 2018 SuperTux Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_VIDEO_SDL_SDL_VERTEX_BUFFER_HPP
+#define HEADER_SUPERTUX_VIDEO_SDL_SDL_VERTEX_BUFFER_HPP
+
+#include "video/vertex_buffer.hpp"
+
+/** SDL_Renderer has no buffer objects, so this only keeps the quads
+    around for SDLPainter to draw them one by one */
+class SDLVertexBuffer final : public VertexBuffer
+{
+public:
+  SDLVertexBuffer();
+
+  virtual void set_quads(const Texture& texture,
+                         const std::vector<Rectf>& srcrects,
+                         const std::vector<Rectf>& dstrects,
+                         DrawingEffect effect) override;
+
+  virtual size_t get_quad_count() const override
+  {
+    return m_srcrects.size();
+  }
+
+  const std::vector<Rectf>& get_srcrects() const { return m_srcrects; }
+  const std::vector<Rectf>& get_dstrects() const { return m_dstrects; }
+  DrawingEffect get_effect() const { return m_effect; }
+
+private:
+  std::vector<Rectf> m_srcrects;
+  std::vector<Rectf> m_dstrects;
+  DrawingEffect m_effect;
+
+private:
+  SDLVertexBuffer(const SDLVertexBuffer&) = delete;
+  SDLVertexBuffer& operator=(const SDLVertexBuffer&) = delete;
+};
+
+#endif
+
+/* EOF */
@@ -24,6 +24,7 @@
 #include "video/sdl/sdl_lightmap.hpp"
 #include "video/sdl/sdl_renderer.hpp"
 #include "video/sdl/sdl_texture.hpp"
+#include "video/sdl/sdl_vertex_buffer.hpp"
 
 SDLVideoSystem::SDLVideoSystem() :
   m_sdl_window(),
@@ -179,6 +180,12 @@ SDLVideoSystem::new_texture(SDL_Surface* image)
   return TexturePtr(new SDLTexture(image));
 }
 
+std::unique_ptr<VertexBuffer>
+SDLVideoSystem::new_vertex_buffer()
+{
+  return std::unique_ptr<VertexBuffer>(new SDLVertexBuffer);
+}
+
 void
 SDLVideoSystem::on_resize(int w, int h)
 {
@@ -38,6 +38,7 @@ public:
   virtual Lightmap& get_lightmap() const override;
 
   virtual TexturePtr new_texture(SDL_Surface* image) override;
+  virtual std::unique_ptr<VertexBuffer> new_vertex_buffer() override;
 
   virtual const Viewport& get_viewport() const override { return m_viewport; }
   virtual void apply_config() override;
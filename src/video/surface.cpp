@@ -32,19 +32,19 @@ Surface::create(const std::string& file, const Rect& rect)
 }
 
 Surface::Surface(const std::string& file) :
-  m_texture(TextureManager::current()->get(file)),
-  m_rect(0, 0,
-         Size(m_texture->get_image_width(),
-              m_texture->get_image_height())),
+  m_texture(),
+  m_rect(),
   m_flipx(false)
 {
+  m_texture = TextureManager::current()->get_packed(file, m_rect);
 }
 
 Surface::Surface(const std::string& file, const Rect& rect_) :
-  m_texture(TextureManager::current()->get(file, rect_)),
-  m_rect(0, 0, Size(rect_.get_width(), rect_.get_height())),
+  m_texture(),
+  m_rect(),
   m_flipx(false)
 {
+  m_texture = TextureManager::current()->get_packed(file, rect_, m_rect);
 }
 
 Surface::Surface(const Surface& rhs) :
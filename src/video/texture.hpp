@@ -48,6 +48,10 @@ public:
   virtual unsigned int get_image_width() const = 0;
   virtual unsigned int get_image_height() const = 0;
 
+  /** Copies image into the texture with its top left corner at x, y,
+      used to fill the pages of the TextureAtlas */
+  virtual void update_region(SDL_Surface* image, int x, int y) = 0;
+
 private:
   Texture(const Texture&);
   Texture& operator=(const Texture&);
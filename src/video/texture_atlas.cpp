@@ -0,0 +1,167 @@
+//  SuperTux
+//  Copyright (C) 2018 SuperTux Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "video/texture_atlas.hpp"
+
+#include <SDL.h>
+#include <algorithm>
+#include <stdexcept>
+
+#include "video/sdl_surface_ptr.hpp"
+#include "video/texture.hpp"
+#include "video/video_system.hpp"
+
+namespace {
+
+SDL_Surface* create_rgba_surface(int width, int height)
+{
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+  return SDL_CreateRGBSurface(0, width, height, 32,
+                              0xff000000, 0x00ff0000, 0x0000ff00, 0x000000ff);
+#else
+  return SDL_CreateRGBSurface(0, width, height, 32,
+                              0x000000ff, 0x0000ff00, 0x00ff0000, 0xff000000);
+#endif
+}
+
+void blit(SDL_Surface* src, int sx, int sy, int w, int h,
+          SDL_Surface* dst, int dx, int dy)
+{
+  SDL_Rect src_rect = { sx, sy, w, h };
+  SDL_Rect dst_rect = { dx, dy, w, h };
+  SDL_BlitSurface(src, &src_rect, dst, &dst_rect);
+}
+
+} // namespace
+
+TextureAtlas::TextureAtlas(int page_size) :
+  m_page_size(page_size),
+  m_pages()
+{
+}
+
+bool
+TextureAtlas::add(SDL_Surface* image, TexturePtr& texture, Rect& region)
+{
+  const int w = image->w;
+  const int h = image->h;
+
+  if (w <= 0 || h <= 0 || w + 2 > m_page_size || h + 2 > m_page_size)
+    return false;
+
+  // the space of pages nobody draws from anymore is gone with their texture
+  m_pages.erase(std::remove_if(m_pages.begin(), m_pages.end(),
+                               [](const Page& p) { return p.texture.expired(); }),
+                m_pages.end());
+
+  int x = 0;
+  int y = 0;
+  TexturePtr page_texture;
+  auto page = std::find_if(m_pages.begin(), m_pages.end(),
+                           [&](Page& p) { return place(p, w + 2, h + 2, x, y); });
+  if (page == m_pages.end())
+  {
+    page_texture = new_page();
+    page = m_pages.end() - 1;
+    if (!place(*page, w + 2, h + 2, x, y))
+      return false;
+  }
+  else
+  {
+    page_texture = page->texture.lock();
+  }
+
+  // the image plus a copy of its outermost pixels around it
+  SDLSurfacePtr padded(create_rgba_surface(w + 2, h + 2));
+  if (!padded)
+  {
+    throw std::runtime_error("Couldn't create atlas image: out of memory");
+  }
+
+  SDL_BlendMode blend_mode;
+  SDL_GetSurfaceBlendMode(image, &blend_mode);
+  SDL_SetSurfaceBlendMode(image, SDL_BLENDMODE_NONE);
+
+  blit(image, 0, 0, w, h, padded.get(), 1, 1);
+
+  blit(image, 0, 0, w, 1, padded.get(), 1, 0);
+  blit(image, 0, h - 1, w, 1, padded.get(), 1, h + 1);
+  blit(image, 0, 0, 1, h, padded.get(), 0, 1);
+  blit(image, w - 1, 0, 1, h, padded.get(), w + 1, 1);
+
+  blit(image, 0, 0, 1, 1, padded.get(), 0, 0);
+  blit(image, w - 1, 0, 1, 1, padded.get(), w + 1, 0);
+  blit(image, 0, h - 1, 1, 1, padded.get(), 0, h + 1);
+  blit(image, w - 1, h - 1, 1, 1, padded.get(), w + 1, h + 1);
+
+  SDL_SetSurfaceBlendMode(image, blend_mode);
+
+  page_texture->update_region(padded.get(), x, y);
+
+  texture = page_texture;
+  region = Rect(x + 1, y + 1, x + 1 + w, y + 1 + h);
+  return true;
+}
+
+bool
+TextureAtlas::place(Page& page, int width, int height, int& x, int& y) const
+{
+  int shelf_x = page.shelf_x;
+  int shelf_y = page.shelf_y;
+  int shelf_height = page.shelf_height;
+
+  if (shelf_x + width > m_page_size)
+  {
+    // start a new shelf below the current one
+    shelf_x = 0;
+    shelf_y += shelf_height;
+    shelf_height = 0;
+  }
+
+  if (shelf_y + height > m_page_size)
+    return false;
+
+  x = shelf_x;
+  y = shelf_y;
+  page.shelf_x = shelf_x + width;
+  page.shelf_y = shelf_y;
+  page.shelf_height = std::max(shelf_height, height);
+  return true;
+}
+
+TexturePtr
+TextureAtlas::new_page()
+{
+  SDLSurfacePtr image(create_rgba_surface(m_page_size, m_page_size));
+  if (!image)
+  {
+    throw std::runtime_error("Couldn't create atlas page: out of memory");
+  }
+  SDL_FillRect(image.get(), NULL, 0);
+
+  TexturePtr texture = VideoSystem::current()->new_texture(image.get());
+
+  Page page;
+  page.texture = texture;
+  page.shelf_x = 0;
+  page.shelf_y = 0;
+  page.shelf_height = 0;
+  m_pages.push_back(page);
+  return texture;
+}
+
+/* EOF */
@@ -0,0 +1,72 @@
+//  SuperTux
+//  Copyright (C) 2018 SuperTux Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef HEADER_SUPERTUX_VIDEO_TEXTURE_ATLAS_HPP
+#define HEADER_SUPERTUX_VIDEO_TEXTURE_ATLAS_HPP
+
+#include <memory>
+#include <vector>
+
+#include "math/rect.hpp"
+#include "video/texture_ptr.hpp"
+
+class Texture;
+struct SDL_Surface;
+
+/**
+ * Packs small images into a few large textures ("pages"), so that
+ * Canvas can merge consecutive draws of different images into a
+ * single draw call. Images are placed on shelves, which is good
+ * enough for the mostly equally sized tiles and sprite frames.
+ * Every image gets a one pixel border copied from its edges to
+ * avoid bleeding of the neighbours with linear filtering.
+ * The atlas doesn't keep its pages alive, a page is freed together
+ * with the last Surface using it.
+ */
+class TextureAtlas final
+{
+public:
+  TextureAtlas(int page_size = 1024);
+
+  /** Copies image into one of the pages. Returns false if the image
+      is too large to ever fit into a page. */
+  bool add(SDL_Surface* image, TexturePtr& texture, Rect& region);
+
+private:
+  struct Page
+  {
+    std::weak_ptr<Texture> texture;
+    int shelf_x;
+    int shelf_y;
+    int shelf_height;
+  };
+
+  bool place(Page& page, int width, int height, int& x, int& y) const;
+  TexturePtr new_page();
+
+private:
+  int m_page_size;
+  std::vector<Page> m_pages;
+
+private:
+  TextureAtlas(const TextureAtlas&) = delete;
+  TextureAtlas& operator=(const TextureAtlas&) = delete;
+};
+
+#endif
+
+/* EOF */
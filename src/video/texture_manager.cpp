@@ -21,16 +21,34 @@
 
 #include "math/rect.hpp"
 #include "physfs/physfs_sdl.hpp"
+#include "supertux/gameconfig.hpp"
+#include "supertux/globals.hpp"
 #include "util/file_system.hpp"
 #include "util/log.hpp"
 #include "video/sdl_surface_ptr.hpp"
 #include "video/texture.hpp"
+#include "video/texture_atlas.hpp"
 #include "video/video_system.hpp"
 
+namespace {
+
+// larger images get a texture of their own
+const int MAX_PACKED_SIZE = 256;
+
+} // namespace
+
 TextureManager::TextureManager() :
   m_image_textures(),
-  m_surfaces()
+  m_surfaces(),
+  m_preloaded(),
+  m_preloaded_mutex(),
+  m_atlas(),
+  m_atlas_regions()
 {
+  if (g_config && g_config->use_texture_atlas)
+  {
+    m_atlas.reset(new TextureAtlas);
+  }
 }
 
 TextureManager::~TextureManager()
@@ -43,12 +61,16 @@ TextureManager::~TextureManager()
     }
   }
   m_image_textures.clear();
+  m_atlas_regions.clear();
+  m_atlas.reset();
 
   for(auto& surface : m_surfaces)
   {
     SDL_FreeSurface(surface.second);
   }
   m_surfaces.clear();
+
+  drop_preloaded();
 }
 
 TexturePtr
@@ -74,11 +96,7 @@ TexturePtr
 TextureManager::get(const std::string& _filename, const Rect& rect)
 {
   std::string filename = FileSystem::normalize(_filename);
-  std::string key = filename + "_" +
-                    std::to_string(rect.left)  + "|" +
-                    std::to_string(rect.top)   + "|" +
-                    std::to_string(rect.right) + "|" +
-                    std::to_string(rect.bottom);
+  std::string key = get_cache_key(filename, rect);
   auto i = m_image_textures.find(key);
 
   TexturePtr texture;
@@ -94,6 +112,203 @@ TextureManager::get(const std::string& _filename, const Rect& rect)
   return texture;
 }
 
+TexturePtr
+TextureManager::get_packed(const std::string& _filename, Rect& region)
+{
+  if (!m_atlas)
+  {
+    TexturePtr texture = get(_filename);
+    region = Rect(0, 0, Size(texture->get_image_width(), texture->get_image_height()));
+    return texture;
+  }
+
+  std::string filename = FileSystem::normalize(_filename);
+  TexturePtr packed = find_atlas_region(filename, region);
+  if (packed)
+    return packed;
+
+  auto j = m_image_textures.find(filename);
+  if (j != m_image_textures.end())
+  {
+    TexturePtr texture = j->second.lock();
+    if (texture)
+    {
+      region = Rect(0, 0, Size(texture->get_image_width(), texture->get_image_height()));
+      return texture;
+    }
+  }
+
+  SDLSurfacePtr image(load_image_surface(filename));
+  if (!image)
+  {
+    // let get() deal with the dummy texture
+    TexturePtr texture = get(filename);
+    region = Rect(0, 0, Size(texture->get_image_width(), texture->get_image_height()));
+    return texture;
+  }
+
+  return create_packed_texture(filename, image.get(), region);
+}
+
+TexturePtr
+TextureManager::get_packed(const std::string& _filename, const Rect& rect, Rect& region)
+{
+  if (!m_atlas)
+  {
+    region = Rect(0, 0, Size(rect.get_width(), rect.get_height()));
+    return get(_filename, rect);
+  }
+
+  std::string filename = FileSystem::normalize(_filename);
+  std::string key = get_cache_key(filename, rect);
+  TexturePtr packed = find_atlas_region(key, region);
+  if (packed)
+    return packed;
+
+  auto j = m_image_textures.find(key);
+  if (j != m_image_textures.end())
+  {
+    TexturePtr texture = j->second.lock();
+    if (texture)
+    {
+      region = Rect(0, 0, Size(rect.get_width(), rect.get_height()));
+      return texture;
+    }
+  }
+
+  SDLSurfacePtr subimage;
+  try
+  {
+    subimage.reset(create_image_surface_raw(filename, rect));
+  }
+  catch(const std::exception&)
+  {
+    // let get() deal with the dummy texture
+    region = Rect(0, 0, Size(rect.get_width(), rect.get_height()));
+    return get(filename, rect);
+  }
+
+  return create_packed_texture(key, subimage.get(), region);
+}
+
+void
+TextureManager::preload(const std::string& filename)
+{
+  {
+    std::lock_guard<std::mutex> lock(m_preloaded_mutex);
+    if (m_preloaded.find(filename) != m_preloaded.end())
+      return;
+  }
+
+  // errors are left to the get() that eventually wants the image
+  SDL_Surface* image = nullptr;
+  try
+  {
+    image = IMG_Load_RW(get_physfs_SDLRWops(filename), 1);
+  }
+  catch(const std::exception&)
+  {
+  }
+  if (!image)
+    return;
+
+  std::lock_guard<std::mutex> lock(m_preloaded_mutex);
+  auto result = m_preloaded.insert(std::make_pair(filename, image));
+  if (!result.second)
+    SDL_FreeSurface(image);
+}
+
+bool
+TextureManager::is_loaded(const std::string& filename) const
+{
+  if (m_surfaces.find(filename) != m_surfaces.end())
+    return true;
+
+  auto j = m_atlas_regions.find(filename);
+  if (j != m_atlas_regions.end() && !j->second.texture.expired())
+    return true;
+
+  auto i = m_image_textures.find(filename);
+  return i != m_image_textures.end() && !i->second.expired();
+}
+
+void
+TextureManager::drop_preloaded()
+{
+  std::lock_guard<std::mutex> lock(m_preloaded_mutex);
+  for (auto& image : m_preloaded)
+  {
+    SDL_FreeSurface(image.second);
+  }
+  m_preloaded.clear();
+}
+
+SDL_Surface*
+TextureManager::load_image_surface(const std::string& filename)
+{
+  {
+    std::lock_guard<std::mutex> lock(m_preloaded_mutex);
+    auto i = m_preloaded.find(filename);
+    if (i != m_preloaded.end())
+    {
+      SDL_Surface* image = i->second;
+      m_preloaded.erase(i);
+      return image;
+    }
+  }
+
+  return IMG_Load_RW(get_physfs_SDLRWops(filename), 1);
+}
+
+TexturePtr
+TextureManager::create_packed_texture(const std::string& key, SDL_Surface* image, Rect& region)
+{
+  if (image->w <= MAX_PACKED_SIZE && image->h <= MAX_PACKED_SIZE)
+  {
+    TexturePtr texture;
+    if (m_atlas->add(image, texture, region))
+    {
+      m_atlas_regions[key] = { texture, region };
+      return texture;
+    }
+  }
+
+  TexturePtr texture = VideoSystem::current()->new_texture(image);
+  texture->cache_filename = key;
+  m_image_textures[key] = texture;
+  region = Rect(0, 0, Size(image->w, image->h));
+  return texture;
+}
+
+TexturePtr
+TextureManager::find_atlas_region(const std::string& key, Rect& region)
+{
+  auto i = m_atlas_regions.find(key);
+  if (i == m_atlas_regions.end())
+    return TexturePtr();
+
+  TexturePtr texture = i->second.texture.lock();
+  if (!texture)
+  {
+    // the page went away with the last Surface using it
+    m_atlas_regions.erase(i);
+    return TexturePtr();
+  }
+
+  region = i->second.region;
+  return texture;
+}
+
+std::string
+TextureManager::get_cache_key(const std::string& filename, const Rect& rect)
+{
+  return filename + "_" +
+    std::to_string(rect.left)  + "|" +
+    std::to_string(rect.top)   + "|" +
+    std::to_string(rect.right) + "|" +
+    std::to_string(rect.bottom);
+}
+
 void
 TextureManager::reap_cache_entry(const std::string& filename)
 {
@@ -119,6 +334,13 @@ TextureManager::create_image_texture(const std::string& filename, const Rect& re
 
 TexturePtr
 TextureManager::create_image_texture_raw(const std::string& filename, const Rect& rect)
+{
+  SDLSurfacePtr subimage(create_image_surface_raw(filename, rect));
+  return VideoSystem::current()->new_texture(subimage.get());
+}
+
+SDL_Surface*
+TextureManager::create_image_surface_raw(const std::string& filename, const Rect& rect)
 {
   SDL_Surface *image = nullptr;
 
@@ -129,7 +351,7 @@ TextureManager::create_image_texture_raw(const std::string& filename, const Rect
   }
   else
   {
-    image = IMG_Load_RW(get_physfs_SDLRWops(filename), 1);
+    image = load_image_surface(filename);
     if (!image)
     {
       std::ostringstream msg;
@@ -146,22 +368,22 @@ TextureManager::create_image_texture_raw(const std::string& filename, const Rect
     image = SDL_ConvertSurfaceFormat(image, SDL_PIXELFORMAT_RGBA8888, 0);
   }
 
-  SDLSurfacePtr subimage(SDL_CreateRGBSurfaceFrom(static_cast<uint8_t*>(image->pixels) +
-                                                  rect.top * image->pitch +
-                                                  rect.left * image->format->BytesPerPixel,
-                                                  rect.get_width(), rect.get_height(),
-                                                  image->format->BitsPerPixel,
-                                                  image->pitch,
-                                                  image->format->Rmask,
-                                                  image->format->Gmask,
-                                                  image->format->Bmask,
-                                                  image->format->Amask));
+  SDL_Surface* subimage = SDL_CreateRGBSurfaceFrom(static_cast<uint8_t*>(image->pixels) +
+                                                   rect.top * image->pitch +
+                                                   rect.left * image->format->BytesPerPixel,
+                                                   rect.get_width(), rect.get_height(),
+                                                   image->format->BitsPerPixel,
+                                                   image->pitch,
+                                                   image->format->Rmask,
+                                                   image->format->Gmask,
+                                                   image->format->Bmask,
+                                                   image->format->Amask);
   if (!subimage)
   {
     throw std::runtime_error("SDL_CreateRGBSurfaceFrom() call failed");
   }
 
-  return VideoSystem::current()->new_texture(subimage.get());
+  return subimage;
 }
 
 TexturePtr
@@ -181,7 +403,7 @@ TextureManager::create_image_texture(const std::string& filename)
 TexturePtr
 TextureManager::create_image_texture_raw(const std::string& filename)
 {
-  SDLSurfacePtr image(IMG_Load_RW(get_physfs_SDLRWops(filename), 1));
+  SDLSurfacePtr image(load_image_surface(filename));
   if (!image)
   {
     std::ostringstream msg;
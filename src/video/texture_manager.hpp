@@ -20,17 +20,19 @@
 #include <config.h>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <vector>
 
+#include "math/rect.hpp"
 #include "util/currenton.hpp"
 #include "video/glutil.hpp"
 #include "video/texture_ptr.hpp"
 
 class Texture;
+class TextureAtlas;
 class GLTexture;
-class Rect;
 struct SDL_Surface;
 
 class TextureManager : public Currenton<TextureManager>
@@ -45,9 +47,40 @@ public:
   TexturePtr get(const std::string& filename);
   TexturePtr get(const std::string& filename, const Rect& rect);
 
+  /** Like get(), but small images are packed into a page of the
+      texture atlas if enabled. region receives the area of the image
+      within the returned texture. */
+  TexturePtr get_packed(const std::string& filename, Rect& region);
+  TexturePtr get_packed(const std::string& filename, const Rect& rect, Rect& region);
+
+  /** Decodes the image so that a later get() only has to upload it.
+      Can be called from any thread, filename has to be normalized
+      already. */
+  void preload(const std::string& filename);
+
+  /** Returns true if the image is decoded or in use already, so that
+      preloading it would be wasted */
+  bool is_loaded(const std::string& filename) const;
+
+  /** Frees the preloaded images nobody asked for */
+  void drop_preloaded();
+
 private:
   void reap_cache_entry(const std::string& filename);
 
+  static std::string get_cache_key(const std::string& filename, const Rect& rect);
+
+  /** returns the texture for image, packed into the atlas if it is
+      small enough, the texture is cached under key */
+  TexturePtr create_packed_texture(const std::string& key, SDL_Surface* image, Rect& region);
+
+  /** returns the atlas page of key and fills region, nullptr if the
+      image is not packed or its page has been freed */
+  TexturePtr find_atlas_region(const std::string& key, Rect& region);
+
+  /** throw an exception on error, the returned surface has to be freed by the caller */
+  SDL_Surface* create_image_surface_raw(const std::string& filename, const Rect& rect);
+
   TexturePtr create_image_texture(const std::string& filename, const Rect& rect);
 
   /** on failure a dummy texture is returned and no exception is thrown */
@@ -59,9 +92,26 @@ private:
 
   TexturePtr create_dummy_texture();
 
+  /** returns the preloaded image or decodes it, the returned surface
+      has to be freed by the caller, nullptr on error */
+  SDL_Surface* load_image_surface(const std::string& filename);
+
 private:
   std::map<std::string, std::weak_ptr<Texture> > m_image_textures;
   std::map<std::string, SDL_Surface*> m_surfaces;
+
+  /** images decoded by preload(), shared with the loading thread */
+  std::map<std::string, SDL_Surface*> m_preloaded;
+  std::mutex m_preloaded_mutex;
+
+  struct AtlasRegion
+  {
+    std::weak_ptr<Texture> texture;
+    Rect region;
+  };
+
+  std::unique_ptr<TextureAtlas> m_atlas;
+  std::map<std::string, AtlasRegion> m_atlas_regions;
 };
 
 #endif
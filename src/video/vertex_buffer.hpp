@@ -0,0 +1,53 @@
+//  SuperTux
+//  Copyright (C) 2018 SuperTux Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_VIDEO_VERTEX_BUFFER_HPP
+#define HEADER_SUPERTUX_VIDEO_VERTEX_BUFFER_HPP
+
+#include <vector>
+
+#include "math/rectf.hpp"
+#include "video/drawing_effect.hpp"
+
+class Texture;
+
+/** A set of textured quads that stays unchanged over many frames, e.g.
+    the static tiles of a TileMap chunk. Backends can keep a copy of it
+    in video memory, so drawing it doesn't resubmit the geometry. */
+class VertexBuffer
+{
+public:
+  VertexBuffer() {}
+  virtual ~VertexBuffer() {}
+
+  /** Replaces the content of the buffer. srcrects are in pixels of
+      texture, dstrects are relative to the position the buffer is
+      drawn at. The effect is applied to every quad. */
+  virtual void set_quads(const Texture& texture,
+                         const std::vector<Rectf>& srcrects,
+                         const std::vector<Rectf>& dstrects,
+                         DrawingEffect effect) = 0;
+
+  virtual size_t get_quad_count() const = 0;
+
+private:
+  VertexBuffer(const VertexBuffer&) = delete;
+  VertexBuffer& operator=(const VertexBuffer&) = delete;
+};
+
+#endif
+
+/* EOF */
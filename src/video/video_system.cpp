@@ -25,6 +25,7 @@
 #include <savepng.h>
 
 #include "util/log.hpp"
+#include "video/null/null_video_system.hpp"
 #include "video/sdl/sdl_video_system.hpp"
 
 #ifdef HAVE_OPENGL
@@ -60,10 +61,21 @@ VideoSystem::create(VideoSystem::Enum video_system)
       return std::unique_ptr<VideoSystem>(new SDLVideoSystem);
 #endif
 
+    case OPENGL_VBO:
+#ifdef HAVE_OPENGL
+      return std::unique_ptr<VideoSystem>(new GLVideoSystem(true));
+#else
+      log_warning << "OpenGL requested, but missing using SDL fallback" << std::endl;
+      return std::unique_ptr<VideoSystem>(new SDLVideoSystem);
+#endif
+
     case PURE_SDL:
       log_info << "new SDL renderer\n";
       return std::unique_ptr<VideoSystem>(new SDLVideoSystem);
 
+    case NULL_VIDEO:
+      return std::unique_ptr<VideoSystem>(new NullVideoSystem);
+
     default:
       log_fatal << "invalid video system in config" << std::endl;
       assert(false);
@@ -83,17 +95,25 @@ VideoSystem::get_video_system(const std::string &video)
   {
     return OPENGL;
   }
+  else if(video == "opengl-vbo")
+  {
+    return OPENGL_VBO;
+  }
 #endif
   else if(video == "sdl")
   {
     return PURE_SDL;
   }
+  else if(video == "null")
+  {
+    return NULL_VIDEO;
+  }
   else
   {
 #ifdef HAVE_OPENGL
-    throw std::runtime_error("invalid VideoSystem::Enum, valid values are 'auto', 'sdl' and 'opengl'");
+    throw std::runtime_error("invalid VideoSystem::Enum, valid values are 'auto', 'sdl', 'opengl', 'opengl-vbo' and 'null'");
 #else
-    throw std::runtime_error("invalid VideoSystem::Enum, valid values are 'auto' and 'sdl'");
+    throw std::runtime_error("invalid VideoSystem::Enum, valid values are 'auto', 'sdl' and 'null'");
 #endif
   }
 }
@@ -107,8 +127,12 @@ VideoSystem::get_video_string(VideoSystem::Enum video)
       return "auto";
     case OPENGL:
       return "opengl";
+    case OPENGL_VBO:
+      return "opengl-vbo";
     case PURE_SDL:
       return "sdl";
+    case NULL_VIDEO:
+      return "null";
     default:
       log_fatal << "invalid video system in config" << std::endl;
       assert(false);
@@ -17,6 +17,7 @@
 #ifndef HEADER_SUPERTUX_VIDEO_VIDEO_SYSTEM_HPP
 #define HEADER_SUPERTUX_VIDEO_VIDEO_SYSTEM_HPP
 
+#include <memory>
 #include <string>
 
 #include "math/size.hpp"
@@ -28,6 +29,7 @@ class Rect;
 class Renderer;
 class Surface;
 class SurfaceData;
+class VertexBuffer;
 class Viewport;
 class Viewport;
 struct SDL_Surface;
@@ -38,7 +40,9 @@ public:
   enum Enum {
     AUTO_VIDEO,
     OPENGL,
+    OPENGL_VBO,
     PURE_SDL,
+    NULL_VIDEO,
     NUM_SYSTEMS
   };
 
@@ -55,6 +59,7 @@ public:
   virtual Lightmap& get_lightmap() const = 0;
 
   virtual TexturePtr new_texture(SDL_Surface *image) = 0;
+  virtual std::unique_ptr<VertexBuffer> new_vertex_buffer() = 0;
 
   virtual const Viewport& get_viewport() const = 0;
   virtual void apply_config() = 0;
@@ -33,6 +33,8 @@
 #include "supertux/game_session.hpp"
 #include "supertux/gameconfig.hpp"
 #include "supertux/level.hpp"
+#include "supertux/level_metadata_cache.hpp"
+#include "supertux/loading_screen.hpp"
 #include "supertux/menu/menu_storage.hpp"
 #include "supertux/resources.hpp"
 #include "supertux/savegame.hpp"
@@ -59,7 +61,8 @@ static const float CAMERA_PAN_SPEED = 5.0;
 
 namespace worldmap {
 
-WorldMap::WorldMap(const std::string& filename, Savegame& savegame, const std::string& force_spawnpoint_) :
+WorldMap::WorldMap(const std::string& filename, Savegame& savegame, const std::string& force_spawnpoint_,
+                   const ReaderDocument* doc) :
   tux(),
   m_savegame(savegame),
   tileset(nullptr),
@@ -114,7 +117,7 @@ WorldMap::WorldMap(const std::string& filename, Savegame& savegame, const std::s
   SoundManager::current()->preload("sounds/warp.wav");
 
   // load worldmap objects
-  load(filename);
+  load(filename, doc);
 }
 
 WorldMap::~WorldMap()
@@ -181,19 +184,28 @@ WorldMap::change(const std::string& filename, const std::string& force_spawnpoin
 {
   m_savegame.get_player_status()->last_worldmap = filename;
   ScreenManager::current()->pop_screen();
-  ScreenManager::current()->push_screen(std::unique_ptr<Screen>(new WorldMap(filename, m_savegame, force_spawnpoint_)));
+  Savegame& savegame = m_savegame;
+  ScreenManager::current()->push_screen(std::unique_ptr<Screen>(new LoadingScreen(
+    filename,
+    [filename, &savegame, force_spawnpoint_](const ReaderDocument* doc) {
+      return std::unique_ptr<Screen>(new WorldMap(filename, savegame, force_spawnpoint_, doc));
+    })));
 }
 
 void
-WorldMap::load(const std::string& filename)
+WorldMap::load(const std::string& filename, const ReaderDocument* doc)
 {
   map_filename = filename;
   levels_path = FileSystem::dirname(map_filename);
 
   try {
     register_translation_directory(map_filename);
-    auto doc = ReaderDocument::parse(map_filename);
-    auto root = doc.get_root();
+    ReaderDocument parsed_doc;
+    if (!doc) {
+      parsed_doc = ReaderDocument::parse_level(map_filename);
+      doc = &parsed_doc;
+    }
+    auto root = doc->get_root();
 
     if(root.get_name() != "supertux-level")
       throw std::runtime_error("file isn't a supertux-level file.");
@@ -305,6 +317,15 @@ WorldMap::load_level_information(LevelTile& level)
       return;
     }
 
+    if (LevelMetadataCache::current())
+    {
+      LevelMetadata metadata = LevelMetadataCache::current()->get(filename);
+      if (!metadata.title.empty())
+        level.title = metadata.title;
+      level.target_time = metadata.target_time;
+      return;
+    }
+
     register_translation_directory(filename);
     auto doc = ReaderDocument::parse(filename);
     auto root = doc.get_root();
@@ -631,7 +652,13 @@ WorldMap::update(float delta)
 
           // update state and savegame
           save_state();
-          ScreenManager::current()->push_screen(std::unique_ptr<Screen>(new GameSession(levelfile, m_savegame, &level_->statistics)),
+          Statistics* statistics = &level_->statistics;
+          std::unique_ptr<Screen> screen(new LoadingScreen(
+            levelfile,
+            [this, levelfile, statistics](const ReaderDocument* doc) {
+              return std::unique_ptr<Screen>(new GameSession(levelfile, m_savegame, statistics, doc));
+            }));
+          ScreenManager::current()->push_screen(std::move(screen),
                                                 std::unique_ptr<ScreenFade>(new ShrinkFade(shrinkpos, 1.0f)));
           in_level = true;
         } catch(std::exception& e) {
@@ -31,6 +31,7 @@
 
 class Level;
 class PlayerStatus;
+class ReaderDocument;
 class Savegame;
 class Sprite;
 class TileMap;
@@ -119,7 +120,9 @@ private:
   bool panning;
 
 public:
-  WorldMap(const std::string& filename, Savegame& savegame, const std::string& force_spawnpoint = "");
+  /** doc is the already parsed filename, if available */
+  WorldMap(const std::string& filename, Savegame& savegame, const std::string& force_spawnpoint = "",
+           const ReaderDocument* doc = nullptr);
   ~WorldMap();
 
   void add_object(GameObjectPtr object);
@@ -269,7 +272,7 @@ private:
   void draw_status(DrawingContext& context);
   void calculate_total_stats();
 
-  void load(const std::string& filename);
+  void load(const std::string& filename, const ReaderDocument* doc);
   void on_escape_press();
 
   Vector get_camera_pos_for_tux() const;
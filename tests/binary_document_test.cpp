@@ -0,0 +1,132 @@
+//  SuperTux
+//  Copyright (C) 2018 SuperTux Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+#include "util/binary_document.hpp"
+#include "util/reader_document.hpp"
+#include "util/reader_mapping.hpp"
+
+namespace {
+
+const char* const LEVEL =
+  "(supertux-level\n"
+  "  (version 2)\n"
+  "  (name (_ \"Test \\\"Level\\\"\"))\n"
+  "  (sector\n"
+  "    (name \"main\")\n"
+  "    (gravity 10.0)\n"
+  "    (tilemap (solid #t) (width 4) (height 2)\n"
+  "      (tiles 0 0 0 0\n"
+  "             1 2 2 2))\n"
+  "    (spawnpoint (name \"main\") (x 32) (y -64.5))\n"
+  "    (decal (tiles 5 6))))\n";
+
+std::string to_binary(const ReaderDocument& doc)
+{
+  std::ostringstream out;
+  BinaryDocument::write(doc, out);
+  return out.str();
+}
+
+std::string to_text(const ReaderDocument& doc)
+{
+  std::ostringstream out;
+  BinaryDocument::write_text(doc, out);
+  return out.str();
+}
+
+} // namespace
+
+TEST(BinaryDocumentTest, round_trip)
+{
+  std::istringstream in(LEVEL);
+  auto doc = ReaderDocument::parse_level(in);
+
+  std::string data = to_binary(doc);
+  ASSERT_TRUE(BinaryDocument::is_binary(data));
+  ASSERT_FALSE(BinaryDocument::is_binary(LEVEL));
+
+  // ReaderDocument::parse() recognizes the binary format
+  std::istringstream data_in(data);
+  auto bin_doc = ReaderDocument::parse(data_in);
+  ASSERT_EQ(to_text(doc), to_text(bin_doc));
+  ASSERT_EQ(data, to_binary(bin_doc));
+
+  // and the text written for it parses back into the same document
+  std::istringstream text_in(to_text(bin_doc));
+  auto text_doc = ReaderDocument::parse_level(text_in);
+  ASSERT_EQ(data, to_binary(text_doc));
+
+  auto root = bin_doc.get_root();
+  ASSERT_EQ("supertux-level", root.get_name());
+  auto mapping = root.get_mapping();
+
+  std::string name;
+  ASSERT_TRUE(mapping.get("name", name));
+  ASSERT_EQ("Test \"Level\"", name);
+
+  ReaderMapping sector;
+  ASSERT_TRUE(mapping.get("sector", sector));
+
+  float gravity;
+  ASSERT_TRUE(sector.get("gravity", gravity));
+  ASSERT_EQ(10.0f, gravity);
+
+  ReaderMapping tilemap;
+  ASSERT_TRUE(sector.get("tilemap", tilemap));
+
+  bool solid;
+  ASSERT_TRUE(tilemap.get("solid", solid));
+  ASSERT_TRUE(solid);
+
+  std::vector<unsigned int> tiles;
+  ASSERT_TRUE(tilemap.get("tiles", tiles));
+  ASSERT_EQ(std::vector<unsigned int>({0, 0, 0, 0, 1, 2, 2, 2}), tiles);
+
+  ReaderMapping decal;
+  ASSERT_TRUE(sector.get("decal", decal));
+  ASSERT_TRUE(decal.get("tiles", tiles));
+  ASSERT_EQ(std::vector<unsigned int>({5, 6}), tiles);
+
+  ReaderMapping spawnpoint;
+  ASSERT_TRUE(sector.get("spawnpoint", spawnpoint));
+
+  int x;
+  float y;
+  ASSERT_TRUE(spawnpoint.get("x", x));
+  ASSERT_TRUE(spawnpoint.get("y", y));
+  ASSERT_EQ(32, x);
+  ASSERT_EQ(-64.5f, y);
+}
+
+TEST(BinaryDocumentTest, damaged)
+{
+  std::istringstream in(LEVEL);
+  std::string data = to_binary(ReaderDocument::parse_level(in));
+
+  for(size_t len = 0; len < data.size(); ++len)
+  {
+    ASSERT_THROW({BinaryDocument::read(data.substr(0, len), "<test>");}, std::runtime_error);
+  }
+
+  ASSERT_THROW({BinaryDocument::read(data + "x", "<test>");}, std::runtime_error);
+}
+
+/* EOF */
@@ -0,0 +1,103 @@
+//  SuperTux
+//  Copyright (C) 2018 SuperTux Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+
+#include "supertux/collision_grid.hpp"
+
+TEST(CollisionGridTest, query)
+{
+  CollisionGrid grid(64.0f);
+  grid.insert(0, Rectf(0.0f, 0.0f, 32.0f, 32.0f));
+  grid.insert(1, Rectf(200.0f, 0.0f, 232.0f, 32.0f));
+  grid.insert(2, Rectf(16.0f, 16.0f, 150.0f, 48.0f));
+  grid.insert(3, Rectf(-1e12f, -1e12f, 1e12f, 1e12f));
+
+  std::vector<int> result;
+  grid.query(Rectf(20.0f, 20.0f, 30.0f, 30.0f), result);
+  ASSERT_EQ((std::vector<int>{0, 2, 3}), result);
+
+  grid.query(Rectf(232.0f, 32.0f, 240.0f, 40.0f), result);
+  ASSERT_EQ((std::vector<int>{1, 3}), result);
+
+  grid.clear();
+  grid.query(Rectf(20.0f, 20.0f, 30.0f, 30.0f), result);
+  ASSERT_TRUE(result.empty());
+}
+
+TEST(CollisionGridTest, move)
+{
+  CollisionGrid grid(64.0f);
+  grid.insert(0, Rectf(0.0f, 0.0f, 32.0f, 32.0f));
+  grid.insert(1, Rectf(-1e12f, 0.0f, 1e12f, 32.0f));
+
+  grid.move(0, Rectf(0.0f, 0.0f, 32.0f, 32.0f), Rectf(300.0f, 300.0f, 332.0f, 332.0f));
+  grid.move(1, Rectf(-1e12f, 0.0f, 1e12f, 32.0f), Rectf(0.0f, 100.0f, 32.0f, 132.0f));
+
+  std::vector<int> result;
+  grid.query(Rectf(0.0f, 0.0f, 40.0f, 40.0f), result);
+  ASSERT_TRUE(result.empty());
+
+  grid.query(Rectf(310.0f, 310.0f, 320.0f, 320.0f), result);
+  ASSERT_EQ((std::vector<int>{0}), result);
+
+  grid.query(Rectf(10.0f, 110.0f, 20.0f, 120.0f), result);
+  ASSERT_EQ((std::vector<int>{1}), result);
+}
+
+TEST(CollisionGridTest, query_following_push)
+{
+  // 0 overlaps 1 and pushes it into 2, which 1 did not touch before.
+  // 0 is pushed itself by 3 into 4, which it did not touch before either
+  std::vector<Rectf> rects = {
+    Rectf(0.0f, 0.0f, 32.0f, 32.0f),
+    Rectf(24.0f, 0.0f, 56.0f, 32.0f),
+    Rectf(100.0f, 0.0f, 132.0f, 32.0f),
+    Rectf(-8.0f, 500.0f, 8.0f, 516.0f),
+    Rectf(0.0f, 800.0f, 32.0f, 832.0f)
+  };
+
+  CollisionGrid grid(64.0f);
+  for(size_t i = 0; i < rects.size(); ++i)
+    grid.insert(static_cast<int>(i), rects[i]);
+
+  std::vector<std::pair<int, int> > pairs;
+  std::vector<int> candidates;
+  auto get_rect = [&rects](int i) { return rects[i]; };
+  for(int i = 0; i < static_cast<int>(rects.size()); ++i) {
+    grid.query_following(i, get_rect, [&](int j) {
+        if(!rects[i].contains(rects[j]))
+          return;
+        pairs.push_back(std::make_pair(i, j));
+        if(i == 0 && j == 1) {
+          rects[1].move(Vector(60.0f, 0.0f));
+          rects[0].move(Vector(0.0f, 490.0f));
+        }
+        if(i == 0 && j == 3)
+          rects[0].move(Vector(0.0f, 300.0f));
+      }, candidates);
+  }
+
+  std::vector<std::pair<int, int> > expected = {
+    std::make_pair(0, 1),
+    std::make_pair(0, 3),
+    std::make_pair(0, 4),
+    std::make_pair(1, 2)
+  };
+  ASSERT_EQ(expected, pairs);
+}
+
+/* EOF */
@@ -0,0 +1,78 @@
+//  SuperTux
+//  Copyright (C) 2018 SuperTux Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "audio/fragment_ring.hpp"
+
+TEST(FragmentRingTest, full_and_empty)
+{
+  FragmentRing ring(2);
+  ASSERT_EQ(nullptr, ring.begin_read());
+
+  for(size_t i = 0; i < 2; ++i) {
+    FragmentRing::Fragment* fragment = ring.begin_write();
+    ASSERT_NE(nullptr, fragment);
+    fragment->size = i;
+    ring.end_write();
+  }
+  ASSERT_EQ(nullptr, ring.begin_write());
+  ASSERT_EQ(2u, ring.size());
+
+  ASSERT_EQ(0u, ring.begin_read()->size);
+  ring.end_read();
+  ASSERT_NE(nullptr, ring.begin_write());
+  ASSERT_EQ(1u, ring.begin_read()->size);
+  ring.end_read();
+  ASSERT_EQ(nullptr, ring.begin_read());
+}
+
+TEST(FragmentRingTest, threads)
+{
+  const size_t count = 100000;
+  FragmentRing ring(4);
+
+  std::thread writer([&ring, count] {
+      for(size_t i = 0; i < count; ) {
+        FragmentRing::Fragment* fragment = ring.begin_write();
+        if(!fragment) {
+          std::this_thread::yield();
+          continue;
+        }
+        fragment->data.assign(1, static_cast<char>(i));
+        fragment->size = i;
+        ring.end_write();
+        ++i;
+      }
+    });
+
+  for(size_t i = 0; i < count; ) {
+    const FragmentRing::Fragment* fragment = ring.begin_read();
+    if(!fragment) {
+      std::this_thread::yield();
+      continue;
+    }
+    EXPECT_EQ(i, fragment->size);
+    EXPECT_EQ(static_cast<char>(i), fragment->data[0]);
+    ring.end_read();
+    ++i;
+  }
+  writer.join();
+}
+
+/* EOF */
@@ -0,0 +1,41 @@
+//  SuperTux
+//  Copyright (C) 2018 SuperTux Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+
+#include "video/glyph_table.hpp"
+
+TEST(GlyphTableTest, get)
+{
+  GlyphTable<int> table;
+  table.set('a', 1);
+  table.set(0x4e2d, 2);
+  table.set(0x0416, 3);
+  table.set(0x1f600, 4);
+  table.set(0x0416, 5);
+
+  ASSERT_EQ(1, table.get('a'));
+  ASSERT_EQ(2, table.get(0x4e2d));
+  ASSERT_EQ(5, table.get(0x0416));
+  ASSERT_EQ(4, table.get(0x1f600));
+  ASSERT_EQ(3u, table.get_sparse_count());
+
+  ASSERT_EQ(0, table.get('b'));
+  ASSERT_EQ(0, table.get(0x4e2e));
+  ASSERT_EQ(0, table.get(0xffffffff));
+}
+
+/* EOF */
@@ -0,0 +1,118 @@
+//  SuperTux
+//  Copyright (C) 2018 SuperTux Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <random>
+
+#include "video/drawing_request.hpp"
+#include "video/layer_sorter.hpp"
+
+namespace {
+
+std::vector<std::unique_ptr<DrawingRequest> > create_requests(size_t count, int min_layer, int max_layer)
+{
+  std::mt19937 rng(1234);
+  std::uniform_int_distribution<int> dist(min_layer, max_layer);
+
+  std::vector<std::unique_ptr<DrawingRequest> > requests;
+  for(size_t i = 0; i < count; ++i)
+  {
+    requests.emplace_back(new DrawingRequest(FILLRECT));
+    requests.back()->layer = dist(rng);
+  }
+  return requests;
+}
+
+std::vector<DrawingRequest*> get_pointers(const std::vector<std::unique_ptr<DrawingRequest> >& requests)
+{
+  std::vector<DrawingRequest*> result;
+  for(const auto& request : requests)
+    result.push_back(request.get());
+  return result;
+}
+
+void expect_stable_sort(const std::vector<std::unique_ptr<DrawingRequest> >& requests)
+{
+  auto expected = get_pointers(requests);
+  std::stable_sort(expected.begin(), expected.end(),
+                   [](const DrawingRequest* r1, const DrawingRequest* r2){
+                     return r1->layer < r2->layer;
+                   });
+
+  LayerSorter sorter;
+  auto result = get_pointers(requests);
+  sorter.sort(result);
+  ASSERT_EQ(expected, result);
+}
+
+} // namespace
+
+TEST(LayerSorterTest, sort)
+{
+  expect_stable_sort(create_requests(0, -300, 600));
+  expect_stable_sort(create_requests(1, -300, 600));
+  expect_stable_sort(create_requests(3000, -300, 600));
+  expect_stable_sort(create_requests(3000, 0, 3));
+
+  // falls back to std::stable_sort()
+  expect_stable_sort(create_requests(1000, -2000000000, 2000000000));
+}
+
+// micro-benchmark, run with --gtest_also_run_disabled_tests
+TEST(LayerSorterTest, DISABLED_benchmark)
+{
+  const int iterations = 1000;
+  auto requests = create_requests(3000, -300, 600);
+
+  std::vector<DrawingRequest*> work;
+  work.reserve(requests.size());
+
+  auto start = std::chrono::steady_clock::now();
+  for(int i = 0; i < iterations; ++i)
+  {
+    work = get_pointers(requests);
+    std::stable_sort(work.begin(), work.end(),
+                     [](const DrawingRequest* r1, const DrawingRequest* r2){
+                       return r1->layer < r2->layer;
+                     });
+  }
+  auto stable_sort_time = std::chrono::steady_clock::now() - start;
+
+  LayerSorter sorter;
+  start = std::chrono::steady_clock::now();
+  for(int i = 0; i < iterations; ++i)
+  {
+    work = get_pointers(requests);
+    sorter.sort(work);
+  }
+  auto layer_sorter_time = std::chrono::steady_clock::now() - start;
+
+  using std::chrono::microseconds;
+  std::cout << "std::stable_sort: "
+            << std::chrono::duration_cast<microseconds>(stable_sort_time).count() / iterations
+            << "us per frame" << std::endl;
+  std::cout << "LayerSorter:      "
+            << std::chrono::duration_cast<microseconds>(layer_sorter_time).count() / iterations
+            << "us per frame" << std::endl;
+}
+
+/* EOF */
@@ -120,4 +120,123 @@ TEST(ReaderTest, syntax_error)
   ASSERT_THROW({mymapping.get("b", myint);}, std::runtime_error);
 }
 
+TEST(ReaderTest, int_array)
+{
+  std::istringstream in(
+    "(supertux-test\n"
+    "   (tiles 1 2 3\n"
+    "          4 5 6)\n"
+    "   (mystring \"(tiles 7 8 9)\") ; (tiles 10)\n"
+    "   (empty (tiles))\n"
+    "   (notints (tiles 1 2.5))\n"
+    ")\n");
+
+  auto doc = ReaderDocument::parse_level(in);
+  auto mapping = doc.get_root().get_mapping();
+
+  {
+    std::vector<unsigned int> tiles;
+    ASSERT_TRUE(mapping.get("tiles", tiles));
+    ASSERT_EQ(std::vector<unsigned int>({1, 2, 3, 4, 5, 6}), tiles);
+  }
+
+  {
+    std::vector<int> tiles;
+    ASSERT_TRUE(mapping.get("tiles", tiles));
+    ASSERT_EQ(std::vector<int>({1, 2, 3, 4, 5, 6}), tiles);
+  }
+
+  {
+    std::string mystring;
+    mapping.get("mystring", mystring);
+    ASSERT_EQ("(tiles 7 8 9)", mystring);
+  }
+
+  {
+    ReaderMapping empty;
+    ASSERT_TRUE(mapping.get("empty", empty));
+    std::vector<unsigned int> tiles = {1};
+    ASSERT_TRUE(empty.get("tiles", tiles));
+    ASSERT_TRUE(tiles.empty());
+  }
+
+  {
+    ReaderMapping notints;
+    ASSERT_TRUE(mapping.get("notints", notints));
+    std::vector<unsigned int> tiles;
+    ASSERT_THROW({notints.get("tiles", tiles);}, std::runtime_error);
+  }
+}
+
+TEST(ReaderTest, int_array_only_in_levels)
+{
+  std::istringstream in(
+    "(supertux-test\n"
+    "   (tiles 1 2 3)\n"
+    "   (single (tiles 5))\n"
+    ")\n");
+
+  auto doc = ReaderDocument::parse(in);
+  auto root = doc.get_root();
+
+  // the raw sexp still holds the numbers
+  auto const& tiles = doc.get_sexp().as_array()[1].as_array();
+  ASSERT_EQ(4u, tiles.size());
+  ASSERT_EQ("tiles", tiles[0].as_string());
+  ASSERT_EQ(1, tiles[1].as_int());
+  ASSERT_EQ(3, tiles[3].as_int());
+
+  auto mapping = root.get_mapping();
+  std::vector<unsigned int> values;
+  ASSERT_TRUE(mapping.get("tiles", values));
+  ASSERT_EQ(std::vector<unsigned int>({1, 2, 3}), values);
+
+  ReaderMapping single;
+  ASSERT_TRUE(mapping.get("single", single));
+  int value = 0;
+  ASSERT_TRUE(single.get("tiles", value));
+  ASSERT_EQ(5, value);
+}
+
+TEST(ReaderTest, indexed_lookup)
+{
+  std::istringstream in(
+    "(supertux-test\n"
+    "   (a 1) (b 2) (c 3) (d 4) (e 5) (f 6) (g 7) (h 8)\n"
+    "   (a 9)\n"
+    "   (small (x 1) (x 2))\n"
+    "   (broken (a 1) (b 2) (c 3) (d 4) (e 5) (f 6) (g 7) (a 8) 9)\n"
+    ")\n");
+
+  auto doc = ReaderDocument::parse(in);
+  auto mapping = doc.get_root().get_mapping();
+
+  int value = 0;
+  ASSERT_TRUE(mapping.get("h", value));
+  ASSERT_EQ(8, value);
+
+  // the first of duplicate keys wins, as with a linear search
+  ASSERT_TRUE(mapping.get("a", value));
+  ASSERT_EQ(1, value);
+
+  ASSERT_FALSE(mapping.get("missing", value));
+
+  ReaderMapping small;
+  ASSERT_TRUE(mapping.get("small", small));
+  ASSERT_TRUE(small.get("x", value));
+  ASSERT_EQ(1, value);
+
+  // malformed items don't keep earlier keys from being found
+  ReaderMapping broken;
+  ASSERT_TRUE(mapping.get("broken", broken));
+  ASSERT_TRUE(broken.get("a", value));
+  ASSERT_EQ(1, value);
+  ASSERT_THROW({broken.get("missing", value);}, std::runtime_error);
+
+  // copies of a document build their own index
+  ReaderDocument copy = doc;
+  ASSERT_TRUE(copy.get_root().get_mapping().get("g", value));
+  ASSERT_EQ(7, value);
+}
+
 /* EOF */
@@ -0,0 +1,66 @@
+//  SuperTux
+//  Copyright (C) 2018 SuperTux Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+
+#include "audio/sound_buffer_cache.hpp"
+
+TEST(SoundBufferCacheTest, get)
+{
+  SoundBufferCache cache(1000);
+  cache.insert("a.wav", 1, 400);
+  cache.insert("b.wav", 2, 300);
+
+  ASSERT_EQ(1u, cache.get("a.wav"));
+  ASSERT_EQ(0u, cache.get("c.wav"));
+  ASSERT_EQ(700u, cache.get_stats().bytes);
+  ASSERT_EQ(2u, cache.get_stats().buffers);
+  ASSERT_EQ(1, cache.get_stats().hits);
+  ASSERT_EQ(1, cache.get_stats().misses);
+  ASSERT_FALSE(cache.over_budget());
+}
+
+TEST(SoundBufferCacheTest, eviction)
+{
+  SoundBufferCache cache(1000);
+  cache.insert("a.wav", 1, 400);
+  cache.insert("b.wav", 2, 400);
+  cache.insert("c.wav", 3, 400);
+  ASSERT_TRUE(cache.over_budget());
+
+  // a.wav was used last, b.wav is the least recently used one
+  cache.get("a.wav");
+  auto candidates = cache.get_eviction_candidates();
+  ASSERT_EQ(3u, candidates.size());
+  ASSERT_EQ("b.wav", candidates[0].first);
+  ASSERT_EQ(2u, candidates[0].second);
+  ASSERT_EQ("a.wav", candidates[2].first);
+
+  cache.set_pinned({ "b.wav" });
+  candidates = cache.get_eviction_candidates();
+  ASSERT_EQ(2u, candidates.size());
+  ASSERT_EQ("c.wav", candidates[0].first);
+
+  cache.evict("c.wav");
+  ASSERT_FALSE(cache.over_budget());
+  ASSERT_FALSE(cache.contains("c.wav"));
+  ASSERT_EQ(1, cache.get_stats().evictions);
+
+  ASSERT_EQ(2u, cache.clear().size());
+  ASSERT_EQ(0u, cache.get_stats().bytes);
+}
+
+/* EOF */
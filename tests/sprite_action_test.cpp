@@ -0,0 +1,67 @@
+//  SuperTux
+//  Copyright (C) 2018 SuperTux Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "sprite/sprite_action.hpp"
+
+TEST(SpriteActionTest, intern)
+{
+  SpriteAction left("left");
+  SpriteAction right("right");
+
+  ASSERT_EQ(SpriteAction("left"), left);
+  ASSERT_NE(left, right);
+  ASSERT_EQ("left", left.get_name());
+  ASSERT_EQ("right", right.get_name());
+
+  SpriteAction none;
+  ASSERT_NE(left, none);
+  ASSERT_EQ("", none.get_name());
+}
+
+TEST(SpriteActionTest, stable_names)
+{
+  const std::string& name = SpriteAction("stable").get_name();
+  for(int i = 0; i < 10000; ++i)
+    SpriteAction("grow-" + std::to_string(i));
+  ASSERT_EQ("stable", name);
+}
+
+TEST(SpriteActionTest, threads)
+{
+  std::vector<std::thread> threads;
+  std::vector<int> ids(4);
+  for(size_t i = 0; i < ids.size(); ++i) {
+    threads.push_back(std::thread([i, &ids] {
+          for(int j = 0; j < 1000; ++j)
+            SpriteAction("thread-" + std::to_string(j));
+          ids[i] = SpriteAction("thread-999").get_id();
+        }));
+  }
+  for(auto& thread : threads)
+    thread.join();
+
+  for(const auto& id : ids)
+    ASSERT_EQ(SpriteAction("thread-999").get_id(), id);
+  ASSERT_EQ("thread-999", SpriteAction("thread-999").get_name());
+}
+
+/* EOF */
@@ -0,0 +1,107 @@
+//  SuperTux
+//  Copyright (C) 2018 SuperTux Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <string.h>
+
+#include "audio/sound_file.hpp"
+#include "audio/stream_decoder.hpp"
+
+namespace {
+
+class MemorySoundFile final : public SoundFile
+{
+public:
+  MemorySoundFile(size_t length) :
+    m_length(length),
+    m_pos(0),
+    m_resets(0)
+  {
+  }
+
+  virtual size_t read(void* buffer, size_t buffer_size) override
+  {
+    size_t count = std::min(buffer_size, m_length - m_pos);
+    memset(buffer, 1, count);
+    m_pos += count;
+    return count;
+  }
+
+  virtual void reset() override
+  {
+    m_pos = 0;
+    m_resets += 1;
+  }
+
+  size_t m_length;
+  size_t m_pos;
+  int m_resets;
+};
+
+} // namespace
+
+TEST(StreamDecoderTest, decode_until_end_of_file)
+{
+  std::unique_ptr<MemorySoundFile> file(new MemorySoundFile(250));
+  StreamDecoder decoder(std::move(file), 100, 8, 5, false);
+
+  decoder.decode_fragments();
+  ASSERT_EQ(3u, decoder.get_fragment_count());
+  ASSERT_TRUE(decoder.is_end_of_file());
+
+  ASSERT_EQ(100u, decoder.begin_read()->size);
+  decoder.end_read();
+  decoder.end_read();
+  ASSERT_EQ(50u, decoder.begin_read()->size);
+  decoder.end_read();
+  ASSERT_EQ(nullptr, decoder.begin_read());
+
+  decoder.decode_fragments();
+  ASSERT_EQ(0u, decoder.get_fragment_count());
+}
+
+TEST(StreamDecoderTest, looping)
+{
+  MemorySoundFile* file = new MemorySoundFile(250);
+  StreamDecoder decoder(std::unique_ptr<SoundFile>(file), 100, 8, 4, true);
+
+  decoder.decode_fragments();
+  ASSERT_EQ(4u, decoder.get_fragment_count());
+  ASSERT_EQ(1, file->m_resets);
+  for(size_t i = 0; i < 4; ++i) {
+    ASSERT_EQ(100u, decoder.begin_read()->size);
+    decoder.end_read();
+  }
+
+  decoder.set_target_fragments(6);
+  decoder.decode_fragments();
+  ASSERT_EQ(6u, decoder.get_fragment_count());
+}
+
+TEST(StreamDecoderTest, detach)
+{
+  std::unique_ptr<MemorySoundFile> file(new MemorySoundFile(1000));
+  StreamDecoder decoder(std::move(file), 100, 8, 5, false);
+
+  decoder.detach();
+  decoder.decode_fragments();
+  ASSERT_TRUE(decoder.is_detached());
+  ASSERT_EQ(0u, decoder.get_fragment_count());
+}
+
+/* EOF */